@@ -0,0 +1,152 @@
+#include "BBoxFrame.h"
+#include <QJsonArray>
+#include <QtEndian>
+#include <iterator>
+#include <limits>
+
+namespace {
+const char kMagic0 = 'B';
+const char kMagic1 = 'X';
+
+qint16 clampToInt16(int value)
+{
+    return static_cast<qint16>(qBound<int>(std::numeric_limits<qint16>::min(), value,
+                                           std::numeric_limits<qint16>::max()));
+}
+}
+
+bool BBoxFrame::isBBoxFrame(QByteArrayView payload)
+{
+    return payload.size() >= 2 && payload[0] == kMagic0 && payload[1] == kMagic1;
+}
+
+const QString &BBoxFrame::className(ObjectClass objectClass)
+{
+    // 미리 만든 문자열을 공유하므로 객체마다 문자열을 새로 할당하지 않는다
+    // (차량은 서버 JSON 과 같은 철자 "vehical" - LineDrawingDialog 필터가 이 값을 기대함)
+    static const QString names[] = {
+        QStringLiteral("unknown"),
+        QStringLiteral("vehical"),
+        QStringLiteral("person"),
+        QStringLiteral("human")
+    };
+
+    const int index = static_cast<int>(objectClass);
+    return (index >= 0 && index < static_cast<int>(std::size(names))) ? names[index] : names[0];
+}
+
+BBoxFrame::ObjectClass BBoxFrame::classFromName(const QString &type)
+{
+    if (type.compare("vehical", Qt::CaseInsensitive) == 0 || type.compare("vehicle", Qt::CaseInsensitive) == 0) {
+        return ObjectClass::Vehicle;
+    }
+    if (type.compare("person", Qt::CaseInsensitive) == 0) {
+        return ObjectClass::Person;
+    }
+    if (type.compare("human", Qt::CaseInsensitive) == 0) {
+        return ObjectClass::Human;
+    }
+    return ObjectClass::Unknown;
+}
+
+bool BBoxFrame::decode(QByteArrayView payload, QList<BBox> &bboxes, qint64 &timestamp)
+{
+    if (payload.size() < HeaderSize || !isBBoxFrame(payload)) {
+        return false;
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(payload.data());
+    if (data[2] != Version) {
+        return false;
+    }
+
+    const quint16 count = qFromBigEndian<quint16>(data + 4);
+    const quint16 recordSize = qFromBigEndian<quint16>(data + 6);
+    if (recordSize < RecordSize || payload.size() < HeaderSize + qsizetype(count) * recordSize) {
+        return false;
+    }
+
+    timestamp = qFromBigEndian<qint64>(data + 8);
+
+    // 크기만 맞추고 기존 요소/용량을 그대로 덮어쓴다
+    bboxes.resize(count);
+    BBox *out = bboxes.data();
+
+    const uchar *record = data + HeaderSize;
+    for (int i = 0; i < count; ++i, record += recordSize) {
+        BBox &bbox = out[i];
+        bbox.object_id = static_cast<int>(qFromBigEndian<quint32>(record));
+        bbox.rect.setRect(qFromBigEndian<qint16>(record + 4),
+                          qFromBigEndian<qint16>(record + 6),
+                          qFromBigEndian<qint16>(record + 8),
+                          qFromBigEndian<qint16>(record + 10));
+        bbox.type = className(static_cast<ObjectClass>(record[12]));
+        bbox.confidence = record[13] / 255.0;
+    }
+
+    return true;
+}
+
+void BBoxFrame::fromJson(const QJsonObject &jsonObj, QList<BBox> &bboxes, qint64 &timestamp)
+{
+    bboxes.clear();
+    // 타임스탬프가 없으면 0 (수신 시각으로 채우면 비디오와 맞출 때 캡처 시각처럼 보임)
+    timestamp = 0;
+
+    if (jsonObj.contains("bboxes") && jsonObj["bboxes"].isArray()) {
+        QJsonArray bboxArray = jsonObj["bboxes"].toArray();
+        bboxes.reserve(bboxArray.size());
+
+        for (int i = 0; i < bboxArray.size(); ++i) {
+            QJsonObject bboxObj = bboxArray[i].toObject();
+
+            BBox bbox;
+            bbox.object_id = bboxObj["id"].toInt();
+            bbox.type = bboxObj["type"].toString();
+            bbox.confidence = bboxObj["confidence"].toDouble();
+            bbox.rect = QRect(
+                bboxObj["x"].toInt(),
+                bboxObj["y"].toInt(),
+                bboxObj["width"].toInt(),
+                bboxObj["height"].toInt()
+            );
+
+            bboxes.append(bbox);
+        }
+    }
+
+    // 타임스탬프가 JSON에 포함되어 있다면 사용
+    if (jsonObj.contains("timestamp")) {
+        timestamp = jsonObj["timestamp"].toVariant().toLongLong();
+    }
+}
+
+QByteArray BBoxFrame::encode(const QList<BBox> &bboxes, qint64 timestamp)
+{
+    const int count = qMin<qsizetype>(bboxes.size(), std::numeric_limits<quint16>::max());
+
+    QByteArray payload(HeaderSize + count * RecordSize, Qt::Uninitialized);
+    uchar *data = reinterpret_cast<uchar *>(payload.data());
+
+    data[0] = kMagic0;
+    data[1] = kMagic1;
+    data[2] = Version;
+    data[3] = 0;
+    qToBigEndian<quint16>(static_cast<quint16>(count), data + 4);
+    qToBigEndian<quint16>(static_cast<quint16>(RecordSize), data + 6);
+    qToBigEndian<qint64>(timestamp, data + 8);
+
+    uchar *record = data + HeaderSize;
+    for (int i = 0; i < count; ++i, record += RecordSize) {
+        const BBox &bbox = bboxes[i];
+        qToBigEndian<quint32>(static_cast<quint32>(bbox.object_id), record);
+        qToBigEndian<qint16>(clampToInt16(bbox.rect.x()), record + 4);
+        qToBigEndian<qint16>(clampToInt16(bbox.rect.y()), record + 6);
+        qToBigEndian<qint16>(clampToInt16(bbox.rect.width()), record + 8);
+        qToBigEndian<qint16>(clampToInt16(bbox.rect.height()), record + 10);
+        record[12] = static_cast<uchar>(classFromName(bbox.type));
+        record[13] = static_cast<uchar>(qBound(0, qRound(bbox.confidence * 255.0), 255));
+    }
+
+    return payload;
+}
@@ -0,0 +1,61 @@
+#ifndef BBOXFRAME_H
+#define BBOXFRAME_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QJsonObject>
+#include <QList>
+
+#include "TcpCommunicator.h"
+
+// response_id 200 (BBox) 전용 고정 레이아웃 바이너리 프레임
+//
+// 헤더 16바이트 (모든 정수는 빅엔디안, 길이 헤더와 동일)
+//   [0..1]   magic 'B' 'X'
+//   [2]      version (1)
+//   [3]      flags (예약, 0)
+//   [4..5]   uint16 객체 수
+//   [6..7]   uint16 레코드 크기 (현재 14, 서버가 필드를 늘려도 앞부분만 읽는다)
+//   [8..15]  int64 캡처 타임스탬프 (ms)
+// 레코드 14바이트
+//   [0..3]   uint32 객체 id
+//   [4..11]  int16 x, y, width, height
+//   [12]     uint8 클래스 (BBoxFrame::ObjectClass)
+//   [13]     uint8 신뢰도 (0~255 → 0.0~1.0)
+//
+// 능력 협상(request_id 30)에서 클라이언트가 지원을 알린 경우에만 서버가 보낸다.
+class BBoxFrame
+{
+public:
+    enum class ObjectClass : quint8 {
+        Unknown = 0,
+        Vehicle = 1,
+        Person = 2,
+        Human = 3
+    };
+
+    static constexpr int Version = 1;
+    static constexpr qsizetype HeaderSize = 16;
+    static constexpr qsizetype RecordSize = 14;
+
+    // 첫 두 바이트가 magic 이면 바이너리 BBox 프레임
+    static bool isBBoxFrame(QByteArrayView payload);
+
+    // 수신 버퍼에서 바로 bboxes 로 디코드. bboxes 의 기존 용량을 재사용하므로
+    // 같은 리스트를 계속 넘기면 객체마다 힙 할당이 일어나지 않는다.
+    static bool decode(QByteArrayView payload, QList<BBox> &bboxes, qint64 &timestamp);
+
+    // JSON 경로 (response_id 200 JSON 프레임, 비교용 벤치마크에서도 사용)
+    static void fromJson(const QJsonObject &jsonObj, QList<BBox> &bboxes, qint64 &timestamp);
+
+    // 서버와 같은 레이아웃으로 인코딩 (벤치마크/재생용)
+    static QByteArray encode(const QList<BBox> &bboxes, qint64 timestamp);
+
+    static ObjectClass classFromName(const QString &type);
+    static const QString &className(ObjectClass objectClass);
+
+private:
+    BBoxFrame() = delete;
+};
+
+#endif // BBOXFRAME_H
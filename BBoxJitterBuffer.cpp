@@ -0,0 +1,104 @@
+#include "BBoxJitterBuffer.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const int kMaxEntries = 64;                 // 25fps 기준 약 2.5초
+const int kMaxSpare = 8;
+const qint64 kMatchToleranceMs = 20;        // 프레임 간격의 절반 정도까지는 같은 프레임으로 봄
+}
+
+BBoxJitterBuffer::BBoxJitterBuffer()
+    : m_clockOffsetMs(0)
+    , m_syncOffsetMs(0)
+    , m_maxAgeMs(500)
+    , m_synchronized(false)
+    , m_shownCaptureMs(-1)
+    , m_overlayCleared(true)
+{
+}
+
+void BBoxJitterBuffer::push(const QList<BBox> &bboxes, qint64 serverTimestampMs)
+{
+    // 받은 배열을 공유하면 I/O 스레드가 그 배열을 다시 쓰지 못하므로 보관용 배열에 원소를 복사
+    Entry entry{ serverTimestampMs + m_clockOffsetMs, serverTimestampMs, QList<BBox>() };
+    if (!m_spare.isEmpty()) {
+        entry.bboxes = m_spare.takeLast();
+    }
+    entry.bboxes.resize(bboxes.size());
+    std::copy(bboxes.cbegin(), bboxes.cend(), entry.bboxes.begin());
+
+    // 대부분 순서대로 오므로 뒤에서부터 자리를 찾음
+    qsizetype index = m_entries.size();
+    while (index > 0 && m_entries.at(index - 1).captureMs > entry.captureMs) {
+        --index;
+    }
+    m_entries.insert(index, entry);
+
+    while (m_entries.size() > kMaxEntries) {
+        release(m_entries.takeFirst());
+    }
+}
+
+bool BBoxJitterBuffer::takeForFrame(qint64 frameCaptureMs, QList<BBox> &bboxes, qint64 &timestampMs)
+{
+    if (frameCaptureMs < 0) {
+        if (m_synchronized) {
+            qDebug() << "[BBoxSync] 프레임 캡처 시각을 모름 - 동기화 없이 그림";
+        }
+        m_synchronized = false;
+        return false;
+    }
+    m_synchronized = true;
+    frameCaptureMs -= m_syncOffsetMs;
+
+    // 프레임 캡처 시각 이전의 가장 최근 것을 고르고, 그보다 오래된 것은 버림
+    qsizetype match = -1;
+    for (qsizetype i = 0; i < m_entries.size(); ++i) {
+        if (m_entries.at(i).captureMs > frameCaptureMs + kMatchToleranceMs) {
+            break;
+        }
+        match = i;
+    }
+
+    if (match < 0) {
+        return false;
+    }
+
+    const Entry &entry = m_entries.at(match);
+    bool changed;
+    if (frameCaptureMs - entry.captureMs > m_maxAgeMs) {
+        // 화면 프레임에 맞는 BBox 가 너무 오래됨 - 잘못된 위치를 그리느니 지움
+        changed = !m_overlayCleared;
+        bboxes.clear();
+        timestampMs = entry.serverTimestampMs;
+        m_overlayCleared = true;
+    } else {
+        changed = entry.captureMs != m_shownCaptureMs || m_overlayCleared;
+        bboxes = entry.bboxes;
+        timestampMs = entry.serverTimestampMs;
+        m_shownCaptureMs = entry.captureMs;
+        m_overlayCleared = false;
+    }
+
+    // 고른 것은 다음 프레임에도 쓸 수 있게 남기고 그 앞만 버림
+    for (qsizetype i = 0; i < match; ++i) {
+        release(m_entries.takeFirst());
+    }
+    return changed;
+}
+
+void BBoxJitterBuffer::release(Entry &&entry)
+{
+    if (m_spare.size() < kMaxSpare && entry.bboxes.isDetached()) {
+        m_spare.append(std::move(entry.bboxes));
+    }
+}
+
+void BBoxJitterBuffer::clear()
+{
+    m_entries.clear();
+    m_synchronized = false;
+    m_shownCaptureMs = -1;
+    m_overlayCleared = true;
+}
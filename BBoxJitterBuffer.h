@@ -0,0 +1,56 @@
+#ifndef BBOXJITTERBUFFER_H
+#define BBOXJITTERBUFFER_H
+
+#include <QList>
+
+#include "TcpCommunicator.h"
+
+// BBox 프레임을 캡처 시각 순으로 잠깐 보관했다가, 화면에 올라온 비디오 프레임의 캡처 시각에 맞는 것을 꺼낸다.
+//
+// 비디오 프레임의 캡처 시각은 RtspStreamSource::captureTimeMs 가 PLAY 기준으로 추정한 값을 받는다
+// (화면 도착 시각이 아니므로 디코드/재생 버퍼링 시간이 빠져 있음). 남는 차이는 syncOffsetMs 로 보정한다.
+// 로컬 시각은 ClockSync::monotonicMs 기준이며, 서버 시각과의 차이는 clockOffsetMs 로 맞춘다 (TcpCommunicator::serverToLocalOffsetMs).
+class BBoxJitterBuffer
+{
+public:
+    BBoxJitterBuffer();
+
+    void setClockOffsetMs(qint64 offsetMs) { m_clockOffsetMs = offsetMs; }
+    void setSyncOffsetMs(qint64 offsetMs) { m_syncOffsetMs = offsetMs; }
+    void setMaxAgeMs(qint64 maxAgeMs) { m_maxAgeMs = maxAgeMs; }
+
+    // 서버 캡처 타임스탬프(ms) 를 가진 BBox 프레임 보관
+    void push(const QList<BBox> &bboxes, qint64 serverTimestampMs);
+
+    // 비디오 프레임이 화면에 올라올 때 호출 (frameCaptureMs 는 그 프레임의 캡처 시각, 모르면 -1)
+    // 그 캡처 시각 이전의 가장 최근 BBox 프레임을 꺼낸다. 바뀐 게 없으면 false.
+    // 맞는 것이 maxAge 보다 오래됐으면 빈 리스트로 true (오버레이 지우기)
+    bool takeForFrame(qint64 frameCaptureMs, QList<BBox> &bboxes, qint64 &timestampMs);
+
+    // 캡처 시각을 모르는 프레임이면 동기화 없이 가장 최근 것을 바로 그려야 하는지
+    bool isSynchronized() const { return m_synchronized; }
+    qint64 pending() const { return m_entries.size(); }
+
+    void clear();
+
+private:
+    struct Entry {
+        qint64 captureMs;       // 로컬 시각으로 옮긴 캡처 시각
+        qint64 serverTimestampMs;
+        QList<BBox> bboxes;
+    };
+
+    void release(Entry &&entry);
+
+    QList<Entry> m_entries;     // captureMs 오름차순
+    QList<QList<BBox>> m_spare; // 빠진 항목의 배열 - 다음 push 때 복사해 넣어 받은 배열을 붙잡지 않음
+    qint64 m_clockOffsetMs;
+    qint64 m_syncOffsetMs;
+    qint64 m_maxAgeMs;
+
+    bool m_synchronized;        // 마지막 프레임의 캡처 시각을 알았는지
+    qint64 m_shownCaptureMs;    // 마지막으로 꺼낸 BBox 프레임 (같은 것을 다시 그리지 않도록)
+    bool m_overlayCleared;
+};
+
+#endif // BBOXJITTERBUFFER_H
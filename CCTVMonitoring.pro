@@ -16,7 +16,29 @@ SOURCES += \
     ImageViewerDialog.cpp \
     NetworkConfigDialog.cpp \
     LineDrawingDialog.cpp \
-    EnvConfig.cpp
+    EnvConfig.cpp \
+    FrameDecoder.cpp \
+    TcpIoWorker.cpp \
+    TlsSessionCache.cpp \
+    ReconnectScheduler.cpp \
+    PendingRequest.cpp \
+    MessageHandlerRegistry.cpp \
+    PayloadCodec.cpp \
+    BBoxFrame.cpp \
+    ImageStreamParser.cpp \
+    CaptureCache.cpp \
+    ThumbnailCache.cpp \
+    CaptureGalleryModel.cpp \
+    CaptureTileDelegate.cpp \
+    CaptureHeatStrip.cpp \
+    HourPrefetcher.cpp \
+    TiledImageView.cpp \
+    RtspStreamSource.cpp \
+    CameraTile.cpp \
+    DecodeBudgetScheduler.cpp \
+    CameraGridWidget.cpp \
+    BBoxJitterBuffer.cpp \
+    ClockSync.cpp
 
 # 헤더 파일
 HEADERS += \
@@ -28,6 +50,28 @@ HEADERS += \
     NetworkConfigDialog.h \
     LineDrawingDialog.h \
     EnvConfig.h \
+    FrameDecoder.h \
+    TcpIoWorker.h \
+    TlsSessionCache.h \
+    ReconnectScheduler.h \
+    PendingRequest.h \
+    MessageHandlerRegistry.h \
+    PayloadCodec.h \
+    BBoxFrame.h \
+    ImageStreamParser.h \
+    CaptureCache.h \
+    ThumbnailCache.h \
+    CaptureGalleryModel.h \
+    CaptureTileDelegate.h \
+    CaptureHeatStrip.h \
+    HourPrefetcher.h \
+    TiledImageView.h \
+    RtspStreamSource.h \
+    CameraTile.h \
+    DecodeBudgetScheduler.h \
+    CameraGridWidget.h \
+    BBoxJitterBuffer.h \
+    ClockSync.h \
     custommessagebox.h
 
 # 리소스 파일
@@ -0,0 +1,202 @@
+#include "CameraGridWidget.h"
+#include "DecodeBudgetScheduler.h"
+#include <QDebug>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+CameraGridWidget::CameraGridWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_layoutComboBox(nullptr)
+    , m_budgetLabel(nullptr)
+    , m_gridContainer(nullptr)
+    , m_gridLayout(nullptr)
+    , m_scheduler(new DecodeBudgetScheduler(this))
+    , m_gridSize(2)
+    , m_streaming(false)
+{
+    setupUI();
+    connect(m_scheduler, &DecodeBudgetScheduler::rebalanced, this, &CameraGridWidget::onBudgetRebalanced);
+}
+
+CameraGridWidget::~CameraGridWidget()
+{
+    stop();
+}
+
+QList<CameraSource> CameraGridWidget::parseCameraList(const QString &spec)
+{
+    QList<CameraSource> cameras;
+    const QStringList entries = spec.split(',', Qt::SkipEmptyParts);
+    for (const QString &entry : entries) {
+        const QStringList urls = entry.split('|');
+        CameraSource camera;
+        camera.name = QString("CAM %1").arg(cameras.size() + 1);
+        camera.url = urls.value(0).trimmed();
+        camera.subUrl = urls.value(1).trimmed();
+        if (!camera.url.isEmpty()) {
+            cameras.append(camera);
+        }
+    }
+    return cameras;
+}
+
+void CameraGridWidget::setupUI()
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setSpacing(0);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    // 상단 바 (VideoStreamWidget 과 같은 높이/색)
+    QWidget *headerWidget = new QWidget();
+    headerWidget->setFixedHeight(50);
+    QHBoxLayout *headerLayout = new QHBoxLayout(headerWidget);
+    headerLayout->setContentsMargins(10, 4, 10, 4);
+    headerLayout->setSpacing(10);
+
+    m_layoutComboBox = new QComboBox();
+    for (int columns = 1; columns <= 4; ++columns) {
+        m_layoutComboBox->addItem(QString("%1x%1").arg(columns), columns);
+    }
+    m_layoutComboBox->setCurrentIndex(m_gridSize - 1);
+    m_layoutComboBox->setStyleSheet("QComboBox { background-color: #3b3e52; color: white; border: none; "
+                                    "border-radius: 6px; padding: 4px 10px; }");
+    connect(m_layoutComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        setGridSize(m_layoutComboBox->itemData(index).toInt());
+    });
+    headerLayout->addWidget(m_layoutComboBox);
+
+    m_budgetLabel = new QLabel();
+    m_budgetLabel->setStyleSheet("color: #cccccc; font-size: 12px;");
+    headerLayout->addWidget(m_budgetLabel);
+
+    headerLayout->addStretch();
+
+    const QString buttonStyle = "QPushButton { background-color: #3b3e52; border: none; border-radius: 6px; color: white; }"
+                                "QPushButton:hover { background-color: #4b4f68; }";
+
+    QPushButton *drawButton = new QPushButton();
+    drawButton->setIcon(QIcon(":/icons/draw.png"));
+    drawButton->setIconSize(QSize(22, 22));
+    drawButton->setFixedSize(36, 36);
+    drawButton->setCursor(Qt::PointingHandCursor);
+    drawButton->setStyleSheet(buttonStyle);
+    connect(drawButton, &QPushButton::clicked, this, &CameraGridWidget::drawButtonClicked);
+    headerLayout->addWidget(drawButton);
+
+    QPushButton *stopButton = new QPushButton("■");
+    stopButton->setFixedSize(36, 36);
+    stopButton->setCursor(Qt::PointingHandCursor);
+    stopButton->setStyleSheet(buttonStyle);
+    connect(stopButton, &QPushButton::clicked, this, &CameraGridWidget::stopRequested);
+    headerLayout->addWidget(stopButton);
+
+    layout->addWidget(headerWidget);
+
+    m_gridContainer = new QWidget();
+    m_gridContainer->setStyleSheet("background-color: #000000;");
+    m_gridLayout = new QGridLayout(m_gridContainer);
+    m_gridLayout->setSpacing(2);
+    m_gridLayout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_gridContainer, 1);
+}
+
+void CameraGridWidget::setCameras(const QList<CameraSource> &cameras)
+{
+    m_cameras = cameras;
+    rebuildTiles();
+}
+
+void CameraGridWidget::setGridSize(int columns)
+{
+    columns = qBound(1, columns, 4);
+    if (columns == m_gridSize) {
+        return;
+    }
+    m_gridSize = columns;
+    m_layoutComboBox->setCurrentIndex(columns - 1);
+    rebuildTiles();
+}
+
+void CameraGridWidget::rebuildTiles()
+{
+    // 보이지 않게 되는 칸은 소스에서 떨어져 세션이 닫힌다
+    for (CameraTile *tile : std::as_const(m_tiles)) {
+        tile->stop();
+    }
+    m_tiles.clear();
+
+    QLayoutItem *item;
+    while ((item = m_gridLayout->takeAt(0)) != nullptr) {
+        delete item->widget();
+        delete item;
+    }
+
+    const int cellCount = m_gridSize * m_gridSize;
+    for (int cell = 0; cell < cellCount; ++cell) {
+        QWidget *widget;
+        if (cell < m_cameras.size()) {
+            CameraTile *tile = new CameraTile(m_cameras.at(cell));
+            connect(tile, &CameraTile::clicked, m_scheduler, &DecodeBudgetScheduler::setFocusedTile);
+            m_tiles.append(tile);
+            widget = tile;
+        } else {
+            QLabel *empty = new QLabel("카메라 없음");
+            empty->setAlignment(Qt::AlignCenter);
+            empty->setStyleSheet("color: #555555; background-color: #1e1e2f;");
+            widget = empty;
+        }
+        m_gridLayout->addWidget(widget, cell / m_gridSize, cell % m_gridSize);
+    }
+    for (int index = 0; index < m_gridSize; ++index) {
+        m_gridLayout->setRowStretch(index, 1);
+        m_gridLayout->setColumnStretch(index, 1);
+    }
+
+    m_scheduler->setTiles(m_tiles);
+    if (m_streaming) {
+        for (CameraTile *tile : std::as_const(m_tiles)) {
+            tile->start();
+        }
+    }
+    qDebug() << "[Grid] 배치:" << m_gridSize << "x" << m_gridSize << "- 카메라" << m_tiles.size() << "대";
+}
+
+void CameraGridWidget::start()
+{
+    if (m_streaming) {
+        return;
+    }
+    m_streaming = true;
+    // 모드를 먼저 정한 뒤 연결 (서브 스트림 칸이 원본 세션을 잠깐 열지 않도록)
+    m_scheduler->rebalance();
+    for (CameraTile *tile : std::as_const(m_tiles)) {
+        tile->start();
+    }
+    m_scheduler->start();
+}
+
+void CameraGridWidget::stop()
+{
+    if (!m_streaming) {
+        return;
+    }
+    m_streaming = false;
+    m_scheduler->stop();
+    for (CameraTile *tile : std::as_const(m_tiles)) {
+        tile->stop();
+    }
+    m_budgetLabel->clear();
+}
+
+void CameraGridWidget::onBudgetRebalanced(qint64 plannedPixelRate, qint64 measuredPixelRate, qint64 budget)
+{
+    if (!m_streaming) {
+        return;
+    }
+    m_budgetLabel->setText(QString("디코드 예산: 계획 %1 / 측정 %2 / 한도 %3 Mpx/s")
+                               .arg(plannedPixelRate / 1000000).arg(measuredPixelRate / 1000000)
+                               .arg(budget / 1000000));
+    m_budgetLabel->setStyleSheet(QString("color: %1; font-size: 12px;")
+                                     .arg(measuredPixelRate > budget ? "#f44336" : "#cccccc"));
+}
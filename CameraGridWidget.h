@@ -0,0 +1,59 @@
+#ifndef CAMERAGRIDWIDGET_H
+#define CAMERAGRIDWIDGET_H
+
+#include <QWidget>
+#include <QComboBox>
+#include <QGridLayout>
+#include <QLabel>
+#include <QList>
+
+#include "CameraTile.h"
+
+class DecodeBudgetScheduler;
+
+// 라이브 탭의 N 카메라 그리드 (1x1, 2x2, 3x3, 4x4)
+// 상단 바에서 배치를 고르고, 칸을 누르면 그 칸이 선택되어 원본 전체 fps 를 우선 받는다.
+class CameraGridWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CameraGridWidget(QWidget *parent = nullptr);
+    ~CameraGridWidget();
+
+    // "메인|서브,메인|서브,..." 형식 (서브는 생략 가능)
+    static QList<CameraSource> parseCameraList(const QString &spec);
+
+    void setCameras(const QList<CameraSource> &cameras);
+    int cameraCount() const { return m_cameras.size(); }
+    void setGridSize(int columns);
+    int gridSize() const { return m_gridSize; }
+
+    void start();
+    void stop();
+    bool isStreaming() const { return m_streaming; }
+
+    DecodeBudgetScheduler *scheduler() const { return m_scheduler; }
+
+signals:
+    void drawButtonClicked();
+    void stopRequested();
+
+private:
+    void setupUI();
+    void rebuildTiles();
+    void onBudgetRebalanced(qint64 plannedPixelRate, qint64 measuredPixelRate, qint64 budget);
+
+    QComboBox *m_layoutComboBox;
+    QLabel *m_budgetLabel;
+    QWidget *m_gridContainer;
+    QGridLayout *m_gridLayout;
+
+    QList<CameraSource> m_cameras;
+    QList<CameraTile *> m_tiles;
+    DecodeBudgetScheduler *m_scheduler;
+    int m_gridSize;
+    bool m_streaming;
+};
+
+#endif // CAMERAGRIDWIDGET_H
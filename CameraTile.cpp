@@ -0,0 +1,337 @@
+#include "CameraTile.h"
+#include "RtspStreamSource.h"
+#include "ReconnectScheduler.h"
+#include <QDebug>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPointer>
+
+namespace {
+const QColor kFocusColor("#f37321");
+const QColor kOverlayColor(0, 0, 0, 150);
+const qint64 kStallTimeoutMs = 15000;       // 이 동안 프레임이 없으면 세션을 다시 연다
+}
+
+CameraTile::CameraTile(const CameraSource &camera, QWidget *parent)
+    : QWidget(parent)
+    , m_camera(camera)
+    , m_sink(new QVideoSink(this))
+    , m_source(nullptr)
+    , m_mode(DecodeMode::Full)
+    , m_streaming(false)
+    , m_focused(false)
+    , m_reconnectScheduler(new ReconnectScheduler(this))
+    , m_statusText("연결 중...")
+    , m_snapshotTimer(new QTimer(this))
+    , m_converting(false)
+    , m_lastFrameMs(0)
+    , m_statsTimer(new QTimer(this))
+    , m_inputFrames(0)
+    , m_shownFrames(0)
+    , m_costSumMs(0.0)
+    , m_inputFps(0.0)
+    , m_shownFps(0.0)
+    , m_convertCostMs(0.0)
+    , m_fullRatePixelRate(0)
+{
+    setMinimumSize(160, 90);
+    setCursor(Qt::PointingHandCursor);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    connect(m_sink, &QVideoSink::videoFrameChanged, this, &CameraTile::onVideoFrameChanged);
+
+    // 한 번에 하나만 변환 - 밀린 프레임은 쌓지 않고 버림
+    m_convertPool.setMaxThreadCount(1);
+
+    // 그리드는 무인 관제 화면이므로 포기하지 않고 계속 재시도
+    m_reconnectScheduler->setNeverGiveUp(true);
+    connect(m_reconnectScheduler, &ReconnectScheduler::reconnectScheduled, this, [this](int attempt, int delayMs) {
+        m_statusText = QString("재연결 대기 중... (%1, %2초 후)").arg(attempt).arg(delayMs / 1000.0, 0, 'f', 1);
+        update();
+    });
+    connect(m_reconnectScheduler, &ReconnectScheduler::reconnectRequested, this, &CameraTile::onReconnectRequested);
+
+    connect(m_snapshotTimer, &QTimer::timeout, this, &CameraTile::takeSnapshot);
+
+    m_statsTimer->setInterval(1000);
+    connect(m_statsTimer, &QTimer::timeout, this, &CameraTile::updateStats);
+    m_clock.start();
+}
+
+CameraTile::~CameraTile()
+{
+    stop();
+    m_convertPool.waitForDone();
+}
+
+void CameraTile::start()
+{
+    if (m_streaming || m_camera.url.isEmpty()) {
+        return;
+    }
+    m_streaming = true;
+    m_statusText = "연결 중...";
+    m_reconnectScheduler->reset();
+    // Snapshot 모드여도 첫 장은 바로 받음
+    attachSource();
+    if (m_mode == DecodeMode::Snapshot) {
+        m_snapshotTimer->start();
+    }
+    m_statsTimer->start();
+}
+
+void CameraTile::stop()
+{
+    if (!m_streaming) {
+        return;
+    }
+    m_streaming = false;
+    m_reconnectScheduler->cancel();
+    m_snapshotTimer->stop();
+    detachSource();
+    m_statsTimer->stop();
+    m_image = QImage();
+    update();
+}
+
+void CameraTile::attachSource()
+{
+    if (m_source) {
+        return;
+    }
+    const QString url = (m_mode == DecodeMode::Substream && hasSubstream()) ? m_camera.subUrl : m_camera.url;
+    m_source = RtspStreamSource::forUrl(url);
+    connect(m_source->player(), &QMediaPlayer::mediaStatusChanged, this, &CameraTile::onMediaStatusChanged);
+    connect(m_source->player(), &QMediaPlayer::errorOccurred, this, &CameraTile::onErrorOccurred);
+    m_lastFrameMs = m_clock.elapsed();
+    m_source->attach(m_sink);
+}
+
+void CameraTile::detachSource()
+{
+    if (m_source) {
+        disconnect(m_source->player(), nullptr, this, nullptr);
+        m_source->detach(m_sink);
+        m_source = nullptr;
+    }
+}
+
+void CameraTile::setDecodeMode(DecodeMode mode, int snapshotIntervalMs)
+{
+    if (mode == DecodeMode::Substream && !hasSubstream()) {
+        mode = DecodeMode::Snapshot;
+    }
+    m_snapshotTimer->setInterval(qMax(1000, snapshotIntervalMs));
+
+    if (mode == m_mode) {
+        return;
+    }
+
+    qDebug() << "[Grid]" << m_camera.name << "디코드 모드 변경:" << int(m_mode) << "->" << int(mode);
+    m_mode = mode;
+    if (m_streaming) {
+        // 모드가 바뀌면 원본/서브 세션이 바뀌거나 세션에서 빠지므로 항상 다시 붙임
+        m_reconnectScheduler->reset();
+        detachSource();
+        if (mode == DecodeMode::Snapshot) {
+            m_snapshotTimer->start();
+        } else {
+            m_snapshotTimer->stop();
+            attachSource();
+        }
+    }
+    update();
+}
+
+void CameraTile::takeSnapshot()
+{
+    // 앞 장을 아직 못 받았으면 그대로 기다림 (멈춤 감지가 정리)
+    if (!m_streaming || m_mode != DecodeMode::Snapshot || m_source) {
+        return;
+    }
+    attachSource();
+}
+
+void CameraTile::setFocused(bool focused)
+{
+    if (m_focused != focused) {
+        m_focused = focused;
+        update();
+    }
+}
+
+qint64 CameraTile::currentPixelRate() const
+{
+    return qint64(m_frameSize.width()) * m_frameSize.height() * m_inputFps;
+}
+
+void CameraTile::onVideoFrameChanged(const QVideoFrame &frame)
+{
+    if (!frame.isValid()) {
+        return;
+    }
+    ++m_inputFrames;
+
+    m_lastFrameMs = m_clock.elapsed();
+    if (m_reconnectScheduler->attempts() > 0 || m_reconnectScheduler->isPending()) {
+        qDebug() << "[Grid]" << m_camera.name << "스트림 복구됨";
+        m_reconnectScheduler->reset();
+    }
+
+    // 앞 프레임을 아직 변환 중이면 버림
+    if (m_converting) {
+        return;
+    }
+    m_converting = true;
+
+    // GPU/YUV 프레임 변환은 무거우므로 GUI 스레드 밖에서 (QVideoFrame 은 암시적 공유라 복사 비용 없음)
+    QPointer<CameraTile> self(this);
+    m_convertPool.start([self, frame]() {
+        QElapsedTimer cost;
+        cost.start();
+        const QImage image = frame.toImage();
+        const double costMs = cost.nsecsElapsed() / 1e6;
+        const QSize frameSize = frame.size();
+        QMetaObject::invokeMethod(self, [self, image, frameSize, costMs]() {
+            if (self) {
+                self->onFrameConverted(image, frameSize, costMs);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void CameraTile::onFrameConverted(const QImage &image, const QSize &frameSize, double costMs)
+{
+    m_converting = false;
+    if (!m_streaming || image.isNull()) {
+        return;
+    }
+
+    m_image = image;
+    m_costSumMs += costMs;
+    m_frameSize = frameSize;
+    ++m_shownFrames;
+    update();
+
+    // 한 장 받았으면 세션에서 빠짐 - 다른 화면이 없으면 세션이 멈춰 디코드도 멈춘다
+    if (m_mode == DecodeMode::Snapshot) {
+        detachSource();
+    }
+}
+
+void CameraTile::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
+{
+    if (!m_streaming) {
+        return;
+    }
+    if (status == QMediaPlayer::EndOfMedia) {
+        scheduleReconnect("스트림 종료");
+    } else if (status == QMediaPlayer::InvalidMedia) {
+        scheduleReconnect("잘못된 미디어");
+    }
+}
+
+void CameraTile::onErrorOccurred(QMediaPlayer::Error error, const QString &errorString)
+{
+    if (!m_streaming || error == QMediaPlayer::NoError) {
+        return;
+    }
+    scheduleReconnect(errorString);
+}
+
+void CameraTile::scheduleReconnect(const QString &reason)
+{
+    // 이미 예약되어 있으면 ReconnectScheduler 가 무시
+    if (!m_reconnectScheduler->isPending()) {
+        qDebug() << "[Grid]" << m_camera.name << "스트림 실패 - 재연결 예약:" << reason;
+    }
+    m_image = QImage();
+    m_statusText = "연결 실패: " + reason;
+    update();
+    if (m_mode == DecodeMode::Snapshot) {
+        // 세션에서 빠지고 다음 주기에 다시 붙는 것으로 재시도
+        detachSource();
+        return;
+    }
+    m_reconnectScheduler->schedule();
+}
+
+void CameraTile::onReconnectRequested(int attempt)
+{
+    if (!m_streaming || !m_source) {
+        return;
+    }
+    qDebug() << "[Grid]" << m_camera.name << "재연결 시도:" << attempt;
+    m_statusText = QString("재연결 시도 중... (%1)").arg(attempt);
+    m_lastFrameMs = m_clock.elapsed();
+    update();
+    // 세션을 같이 쓰는 다른 화면도 함께 다시 연결됨
+    m_source->restart();
+}
+
+void CameraTile::updateStats()
+{
+    m_inputFps = m_inputFrames;
+    m_shownFps = m_shownFrames;
+    m_convertCostMs = m_shownFrames > 0 ? m_costSumMs / m_shownFrames : 0.0;
+    if (m_mode == DecodeMode::Full && m_inputFrames > 0) {
+        m_fullRatePixelRate = qint64(m_frameSize.width()) * m_frameSize.height() * m_inputFps;
+    }
+    m_inputFrames = 0;
+    m_shownFrames = 0;
+    m_costSumMs = 0.0;
+
+    // 오류 없이 프레임만 멈춘 세션 (카메라 재부팅, 네트워크 단절 등) - 세션에서 빠져 있는 동안은 보지 않음
+    if (m_streaming && m_source && !m_reconnectScheduler->isPending() &&
+        m_clock.elapsed() - m_lastFrameMs > kStallTimeoutMs) {
+        scheduleReconnect("프레임 없음");
+    }
+    update();
+}
+
+void CameraTile::paintEvent(QPaintEvent * /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+
+    if (!m_image.isNull()) {
+        const QSize size = m_image.size().scaled(this->size(), Qt::KeepAspectRatio);
+        const QRect target((width() - size.width()) / 2, (height() - size.height()) / 2,
+                           size.width(), size.height());
+        // 선택된 칸만 부드럽게 (나머지는 그리기 비용 절약)
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, m_focused);
+        painter.drawImage(target, m_image);
+    } else {
+        painter.setPen(QColor("#999999"));
+        painter.drawText(rect(), Qt::AlignCenter | Qt::TextWordWrap, m_streaming ? m_statusText : "정지됨");
+    }
+
+    // 카메라 이름 + 받은 fps + 프레임 변환(toImage) 비용
+    static const char *const modeNames[] = { "FULL", "SNAP", "SUB" };
+    QFont font = painter.font();
+    font.setPixelSize(11);
+    painter.setFont(font);
+    const QString info = QString("%1  [%2]  %3x%4  %5/%6fps  변환 %7ms")
+                             .arg(m_camera.name, modeNames[int(m_mode)])
+                             .arg(m_frameSize.width()).arg(m_frameSize.height())
+                             .arg(m_shownFps, 0, 'f', 0).arg(m_inputFps, 0, 'f', 0)
+                             .arg(m_convertCostMs, 0, 'f', 1);
+    const QRect infoRect(0, height() - 20, width(), 20);
+    painter.fillRect(infoRect, kOverlayColor);
+    painter.setPen(Qt::white);
+    painter.drawText(infoRect.adjusted(6, 0, -6, 0), Qt::AlignVCenter | Qt::AlignLeft, info);
+
+    if (m_focused) {
+        painter.setPen(QPen(kFocusColor, 3));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(rect().adjusted(1, 1, -2, -2));
+    }
+}
+
+void CameraTile::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        emit clicked(this);
+    }
+    QWidget::mousePressEvent(event);
+}
@@ -0,0 +1,110 @@
+#ifndef CAMERATILE_H
+#define CAMERATILE_H
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QMediaPlayer>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVideoFrame>
+#include <QVideoSink>
+
+class RtspStreamSource;
+class ReconnectScheduler;
+
+// 카메라 한 대의 접속 정보 (substream 이 있으면 저해상도 모드에서 사용)
+struct CameraSource {
+    QString name;
+    QString url;
+    QString subUrl;
+};
+
+// 멀티 카메라 그리드의 한 칸
+// 공유 RtspStreamSource 에 자기 QVideoSink 를 붙여 프레임을 받고, 직접 그린다.
+// 프레임 → QImage 변환은 칸마다 스레드 하나에서 하고, 변환 중에 온 프레임은 버려 GUI 스레드가 밀리지 않게 한다.
+// 디코드 모드에 따라 원본/서브 스트림을 고르거나, 세션에서 빠져 있다가 주기적으로 잠깐 붙어 한 장만 받으며,
+// 들어오는 fps, 그리는 fps, 프레임 → QImage 변환 비용을 측정해 칸 위에 표시한다.
+// 세션 오류, 스트림 끝, 일정 시간 프레임이 없으면 ReconnectScheduler 로 세션을 다시 연다 (Snapshot 은 다음 주기에 다시 붙음).
+class CameraTile : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum class DecodeMode {
+        Full,           // 원본 스트림, 모든 프레임
+        Snapshot,       // 평소엔 세션에서 빠져 디코드하지 않고, 주기적으로 원본에 붙어 한 장만 받음
+        Substream       // 서브 스트림 (디코드 자체가 가벼움)
+    };
+
+    explicit CameraTile(const CameraSource &camera, QWidget *parent = nullptr);
+    ~CameraTile();
+
+    void start();
+    void stop();
+    bool isStreaming() const { return m_streaming; }
+    ReconnectScheduler *reconnectScheduler() const { return m_reconnectScheduler; }
+
+    const CameraSource &camera() const { return m_camera; }
+    bool hasSubstream() const { return !m_camera.subUrl.isEmpty(); }
+    void setDecodeMode(DecodeMode mode, int snapshotIntervalMs);
+    DecodeMode decodeMode() const { return m_mode; }
+    void setFocused(bool focused);
+
+    // 최근 1초 측정값
+    QSize frameSize() const { return m_frameSize; }
+    double inputFps() const { return m_inputFps; }
+    double shownFps() const { return m_shownFps; }
+    double convertCostMs() const { return m_convertCostMs; }
+    // 원본 스트림을 모든 프레임 그릴 때의 초당 픽셀 수 (측정 전에는 0)
+    qint64 fullRatePixelRate() const { return m_fullRatePixelRate; }
+    // 최근 1초 동안 실제로 받은(디코드된) 픽셀 수 - Snapshot 은 붙어 있는 동안만 센다
+    qint64 currentPixelRate() const;
+
+signals:
+    void clicked(CameraTile *tile);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+
+private:
+    void onVideoFrameChanged(const QVideoFrame &frame);
+    void onFrameConverted(const QImage &image, const QSize &frameSize, double costMs);
+    void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
+    void onErrorOccurred(QMediaPlayer::Error error, const QString &errorString);
+    void onReconnectRequested(int attempt);
+    void scheduleReconnect(const QString &reason);
+    void updateStats();
+    void takeSnapshot();
+    void attachSource();
+    void detachSource();
+
+    CameraSource m_camera;
+    QVideoSink *m_sink;
+    RtspStreamSource *m_source;
+    DecodeMode m_mode;
+    bool m_streaming;
+    bool m_focused;
+    ReconnectScheduler *m_reconnectScheduler;
+    QString m_statusText;               // 그릴 프레임이 없을 때 표시
+    QTimer *m_snapshotTimer;            // Snapshot 모드에서 다시 붙는 주기
+
+    QThreadPool m_convertPool;          // 스레드 1개 - 프레임 변환
+    bool m_converting;
+    QImage m_image;
+    QElapsedTimer m_clock;
+    qint64 m_lastFrameMs;               // 마지막으로 프레임을 받은 시각 (멈춤 감지)
+
+    QTimer *m_statsTimer;
+    int m_inputFrames;
+    int m_shownFrames;
+    double m_costSumMs;
+    QSize m_frameSize;
+    double m_inputFps;
+    double m_shownFps;
+    double m_convertCostMs;
+    qint64 m_fullRatePixelRate;
+};
+
+#endif // CAMERATILE_H
@@ -0,0 +1,416 @@
+#include "CaptureCache.h"
+#include "ThumbnailCache.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QPair>
+#include <QPointer>
+#include <QSaveFile>
+#include <QSet>
+#include <algorithm>
+
+namespace {
+const quint32 kIndexMagic = 0x43434958;     // "CCIX"
+const quint16 kIndexVersion = 2;          // 2: 탐지 종류/방향/선 인덱스 추가 (1 도 읽음)
+const int kIndexSaveDelayMs = 2000;         // 인덱스 변경을 모아서 한 번에 저장
+const double kEvictTargetRatio = 0.9;       // 한도를 넘으면 90% 까지 비움 (매번 조금씩 지우지 않도록)
+
+QString normalizedTimestamp(const QString &timestamp)
+{
+    QString normalized = timestamp;
+    normalized.replace(' ', 'T');
+    return normalized;
+}
+}
+
+CaptureCache::CaptureCache(QObject *parent)
+    : QObject(parent)
+    , m_saveTimer(new QTimer(this))
+    , m_quotaBytes(0)
+    , m_totalBytes(0)
+{
+    m_ioPool.setMaxThreadCount(1);
+    m_ioPool.setExpiryTimeout(-1);
+
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(kIndexSaveDelayMs);
+    connect(m_saveTimer, &QTimer::timeout, this, &CaptureCache::saveIndex);
+}
+
+CaptureCache::~CaptureCache()
+{
+    if (m_saveTimer->isActive()) {
+        m_saveTimer->stop();
+        saveIndex();
+    }
+    m_ioPool.waitForDone();
+}
+
+void CaptureCache::open(const QString &directory, qint64 quotaBytes)
+{
+    if (!QDir().mkpath(directory)) {
+        qDebug() << "[Cache] 캐시 폴더를 만들 수 없음:" << directory;
+        return;
+    }
+
+    m_directory = directory;
+    m_quotaBytes = quotaBytes;
+    loadIndex();
+    sweepOrphans();
+    evictIfNeeded();
+
+    qDebug() << "[Cache] 캡처 캐시 열림:" << directory << "항목:" << m_entries.size()
+             << "사용:" << m_totalBytes / 1024 << "KB / 한도:" << m_quotaBytes / 1024 << "KB";
+}
+
+void CaptureCache::setQuota(qint64 quotaBytes)
+{
+    m_quotaBytes = quotaBytes;
+    evictIfNeeded();
+}
+
+QString CaptureCache::entryKey(const QString &server, const QString &camera, const QString &timestamp)
+{
+    return server + QChar('|') + camera + QChar('|') + normalizedTimestamp(timestamp);
+}
+
+QString CaptureCache::filePath(const QByteArray &hash) const
+{
+    // 앞 두 글자로 하위 폴더를 나눠 한 폴더에 파일이 몰리지 않게 한다
+    const QString hex = QString::fromLatin1(hash.toHex());
+    return QString("%1/%2/%3.img").arg(m_directory, hex.left(2), hex);
+}
+
+QList<CaptureCache::Entry> CaptureCache::find(const QString &server, const QString &timestampPrefix) const
+{
+    QList<Entry> result;
+    if (!isOpen()) {
+        return result;
+    }
+
+    const QString prefix = normalizedTimestamp(timestampPrefix);
+    for (const Entry &entry : m_entries) {
+        if (entry.server == server && normalizedTimestamp(entry.timestamp).startsWith(prefix)) {
+            result.append(entry);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Entry &a, const Entry &b) {
+        return a.timestamp < b.timestamp;
+    });
+    return result;
+}
+
+void CaptureCache::store(const QString &server, const ImageData &image)
+{
+    if (!isOpen() || image.encodedData.isEmpty() || image.contentHash.isEmpty()) {
+        return;
+    }
+
+    const QString camera = image.cameraId.isEmpty() ? QStringLiteral("default") : image.cameraId;
+    const QString key = entryKey(server, camera, image.timestamp);
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && it->hash == image.contentHash) {
+        touch(key);
+        return;
+    }
+
+    // 같은 키에 다른 내용이면 교체
+    if (it != m_entries.end()) {
+        remove(key);
+    }
+
+    // 같은 내용이 이미 있으면 파일은 다시 쓰지 않는다
+    if (!m_hashRefs.contains(image.contentHash)) {
+        const QString path = filePath(image.contentHash);
+        const QByteArray encodedData = image.encodedData;
+        m_ioPool.start([path, encodedData]() {
+            QDir().mkpath(QFileInfo(path).absolutePath());
+            QSaveFile file(path);
+            if (!file.open(QIODevice::WriteOnly) || file.write(encodedData) != encodedData.size() || !file.commit()) {
+                qDebug() << "[Cache] 캡처 저장 실패:" << path;
+            }
+        });
+    }
+
+    Entry entry;
+    entry.server = server;
+    entry.camera = camera;
+    entry.timestamp = image.timestamp;
+    entry.hash = image.contentHash;
+    entry.size = image.encodedData.size();
+    entry.lastAccessMs = QDateTime::currentMSecsSinceEpoch();
+    entry.detectionType = image.detectionType;
+    entry.direction = image.direction;
+    entry.lineIndex = image.lineIndex;
+    insert(entry);
+
+    evictIfNeeded();
+    scheduleIndexSave();
+}
+
+void CaptureCache::load(const QList<Entry> &entries, QObject *context, LoadHandler onLoaded,
+                        const QSize &thumbnailSize)
+{
+    if (entries.isEmpty()) {
+        return;
+    }
+
+    QList<QPair<Entry, QString>> jobs;
+    jobs.reserve(entries.size());
+    for (const Entry &entry : entries) {
+        jobs.append({ entry, filePath(entry.hash) });
+        touch(entryKey(entry.server, entry.camera, entry.timestamp));
+    }
+
+    // 읽기/디코드는 쓰기와 같은 스레드에서 순서대로 - 방금 store() 한 파일도 기록이 끝난 뒤 읽힌다
+    QPointer<CaptureCache> self(this);
+    m_ioPool.start([self, jobs, context, onLoaded, thumbnailSize]() {
+        for (const auto &job : jobs) {
+            const Entry &entry = job.first;
+
+            ImageData image;
+            image.timestamp = entry.timestamp;
+            image.cameraId = entry.camera;
+            image.contentHash = entry.hash;
+            image.logText = QString("Detection time: %1").arg(entry.timestamp);
+            image.detectionType = entry.detectionType.isEmpty() ? QStringLiteral("vehicle") : entry.detectionType;
+            image.direction = entry.direction.isEmpty() ? QStringLiteral("unknown") : entry.direction;
+            image.lineIndex = entry.lineIndex;
+
+            QFile file(job.second);
+            if (file.open(QIODevice::ReadOnly)) {
+                image.encodedData = file.readAll();
+                image.imagePath = job.second;
+                if (image.encodedData.size() != entry.size || !ThumbnailCache::canRead(image.encodedData)) {
+                    image.encodedData.clear();
+                }
+            }
+
+            if (thumbnailSize.isValid() && !image.encodedData.isEmpty()) {
+                // 목록에는 서버 썸네일과 같은 크기만 - 원본을 메모리에 들고 있지 않도록 여기서 줄여 다시 인코딩
+                const QImage thumbnail = ThumbnailCache::readImage(image.encodedData, thumbnailSize);
+                QByteArray encoded;
+                QBuffer buffer(&encoded);
+                if (!thumbnail.isNull() && buffer.open(QIODevice::WriteOnly) && thumbnail.save(&buffer, "JPEG", 85)) {
+                    image.encodedData = encoded;
+                    image.thumbnailOnly = true;
+                } else {
+                    image.encodedData.clear();
+                }
+            }
+
+            QMetaObject::invokeMethod(context, [self, entry, image, onLoaded]() {
+                if (image.encodedData.isEmpty() && self) {
+                    qDebug() << "[Cache] 캐시 파일 손상/누락 - 항목 제거:" << entry.timestamp;
+                    self->remove(entryKey(entry.server, entry.camera, entry.timestamp));
+                    self->scheduleIndexSave();
+                }
+                onLoaded(entry, image);
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void CaptureCache::insert(const Entry &entry)
+{
+    m_entries.insert(entryKey(entry.server, entry.camera, entry.timestamp), entry);
+    if (m_hashRefs[entry.hash]++ == 0) {
+        m_totalBytes += entry.size;
+    }
+}
+
+void CaptureCache::remove(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    const Entry entry = it.value();
+    m_entries.erase(it);
+
+    auto ref = m_hashRefs.find(entry.hash);
+    if (ref != m_hashRefs.end() && --ref.value() <= 0) {
+        m_hashRefs.erase(ref);
+        m_totalBytes -= entry.size;
+        const QString path = filePath(entry.hash);
+        m_ioPool.start([path]() {
+            QFile::remove(path);
+        });
+    }
+}
+
+void CaptureCache::touch(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        it->lastAccessMs = QDateTime::currentMSecsSinceEpoch();
+        scheduleIndexSave();
+    }
+}
+
+void CaptureCache::evictIfNeeded()
+{
+    if (m_quotaBytes <= 0 || m_totalBytes <= m_quotaBytes) {
+        return;
+    }
+
+    QList<QPair<qint64, QString>> byAge;
+    byAge.reserve(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        byAge.append({ it->lastAccessMs, it.key() });
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    const qint64 target = static_cast<qint64>(m_quotaBytes * kEvictTargetRatio);
+    int evicted = 0;
+    for (const auto &item : byAge) {
+        if (m_totalBytes <= target) {
+            break;
+        }
+        remove(item.second);
+        evicted++;
+    }
+
+    qDebug() << "[Cache] LRU 제거:" << evicted << "항목, 사용:" << m_totalBytes / 1024 << "KB";
+    scheduleIndexSave();
+}
+
+void CaptureCache::scheduleIndexSave()
+{
+    if (isOpen() && !m_saveTimer->isActive()) {
+        m_saveTimer->start();
+    }
+}
+
+void CaptureCache::saveIndex()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    // 서버/카메라 이름은 테이블로 한 번만 쓰고 항목은 번호로 참조
+    QStringList names;
+    QHash<QString, quint16> nameIds;
+    auto nameId = [&](const QString &name) {
+        auto it = nameIds.find(name);
+        if (it == nameIds.end()) {
+            it = nameIds.insert(name, static_cast<quint16>(names.size()));
+            names.append(name);
+        }
+        return it.value();
+    };
+
+    QByteArray body;
+    QDataStream entryStream(&body, QIODevice::WriteOnly);
+    entryStream.setVersion(QDataStream::Qt_6_0);
+    for (const Entry &entry : m_entries) {
+        entryStream << nameId(entry.server) << nameId(entry.camera) << entry.timestamp;
+        entryStream.writeRawData(entry.hash.constData(), entry.hash.size());
+        entryStream << static_cast<quint32>(entry.size) << entry.lastAccessMs
+                    << nameId(entry.detectionType) << nameId(entry.direction) << static_cast<qint16>(entry.lineIndex);
+    }
+
+    QByteArray index;
+    QDataStream stream(&index, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kIndexMagic << kIndexVersion << names << static_cast<quint32>(m_entries.size());
+    stream.writeRawData(body.constData(), body.size());
+
+    const QString path = m_directory + "/index.bin";
+    m_ioPool.start([path, index]() {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(index) != index.size() || !file.commit()) {
+            qDebug() << "[Cache] 인덱스 저장 실패:" << path;
+        }
+    });
+}
+
+void CaptureCache::loadIndex()
+{
+    m_entries.clear();
+    m_hashRefs.clear();
+    m_totalBytes = 0;
+
+    QFile file(m_directory + "/index.bin");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    QStringList names;
+    quint32 count = 0;
+    stream >> magic >> version;
+    if (magic != kIndexMagic || version < 1 || version > kIndexVersion) {
+        qDebug() << "[Cache] 인덱스 형식이 다름 - 새로 시작";
+        return;
+    }
+    stream >> names >> count;
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        quint16 serverId = 0, cameraId = 0;
+        quint32 size = 0;
+        Entry entry;
+        entry.hash.resize(32);
+        stream >> serverId >> cameraId >> entry.timestamp;
+        stream.readRawData(entry.hash.data(), entry.hash.size());
+        stream >> size >> entry.lastAccessMs;
+        quint16 typeId = 0, directionId = 0;
+        qint16 lineIndex = -1;
+        if (version >= 2) {
+            stream >> typeId >> directionId >> lineIndex;
+        }
+        if (stream.status() != QDataStream::Ok || serverId >= names.size() || cameraId >= names.size() ||
+            (version >= 2 && (typeId >= names.size() || directionId >= names.size()))) {
+            break;
+        }
+        entry.server = names[serverId];
+        entry.camera = names[cameraId];
+        if (version >= 2) {
+            entry.detectionType = names[typeId];
+            entry.direction = names[directionId];
+            entry.lineIndex = lineIndex;
+        }
+        entry.size = size;
+        insert(entry);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qDebug() << "[Cache] 인덱스 일부 손상 - 읽은 항목까지만 사용:" << m_entries.size();
+    }
+}
+
+void CaptureCache::sweepOrphans()
+{
+    // 인덱스에 없는 파일(저장 직후 종료 등)과 파일이 없는 항목은 백그라운드에서 정리
+    QSet<QString> known;
+    for (auto it = m_hashRefs.constBegin(); it != m_hashRefs.constEnd(); ++it) {
+        known.insert(QString::fromLatin1(it.key().toHex()) + ".img");
+    }
+
+    const QString directory = m_directory;
+    m_ioPool.start([directory, known]() {
+        int removed = 0;
+        QDirIterator it(directory, { "*.img" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            if (!known.contains(it.fileName()) && QFile::remove(it.filePath())) {
+                removed++;
+            }
+        }
+        if (removed > 0) {
+            qDebug() << "[Cache] 인덱스에 없는 캐시 파일 정리:" << removed;
+        }
+    });
+}
@@ -0,0 +1,84 @@
+#ifndef CAPTURECACHE_H
+#define CAPTURECACHE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <functional>
+
+#include "TcpCommunicator.h"
+
+// 캡처 이미지 디스크 캐시 (GUI 스레드)
+// - 항목 키: (서버, 카메라, 타임스탬프), 파일은 내용 해시(SHA-256)로 저장해 같은 이미지는 한 번만 보관
+// - 용량 한도를 넘으면 가장 오래 쓰지 않은 항목부터 제거 (LRU)
+// - 인덱스는 메모리에 두고 바이너리 파일(index.bin)로 모아서 저장
+// - 파일 쓰기/삭제/읽기와 고아 파일 정리는 전용 백그라운드 스레드 하나에서 순서대로 처리
+class CaptureCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry {
+        QString server;
+        QString camera;
+        QString timestamp;
+        QByteArray hash;            // SHA-256 (raw)
+        qint64 size = 0;
+        qint64 lastAccessMs = 0;
+        QString detectionType;
+        QString direction;
+        int lineIndex = -1;
+    };
+
+    using LoadHandler = std::function<void(const Entry &entry, const ImageData &image)>;
+
+    explicit CaptureCache(QObject *parent = nullptr);
+    ~CaptureCache();
+
+    void open(const QString &directory, qint64 quotaBytes);
+    bool isOpen() const { return !m_directory.isEmpty(); }
+    void setQuota(qint64 quotaBytes);
+
+    // 서버/타임스탬프 접두어(yyyy-MM-ddTHH 또는 yyyy-MM-dd)로 캐시된 항목 조회 (인덱스만 봄)
+    QList<Entry> find(const QString &server, const QString &timestampPrefix) const;
+
+    // 받은 이미지를 캐시에 넣는다 (파일 기록은 백그라운드)
+    void store(const QString &server, const ImageData &image);
+
+    // 항목을 백그라운드에서 읽어 context 스레드에서 하나씩 넘긴다.
+    // 파일이 없거나 손상되었으면 image.encodedData 가 비어 있고 항목은 인덱스에서 빠진다.
+    // thumbnailSize 가 있으면 원본 대신 그 크기로 줄인 JPEG 을 넘긴다 (thumbnailOnly, 목록 조회용)
+    void load(const QList<Entry> &entries, QObject *context, LoadHandler onLoaded,
+              const QSize &thumbnailSize = QSize());
+
+    qint64 totalBytes() const { return m_totalBytes; }
+    int entryCount() const { return m_entries.size(); }
+
+private:
+    static QString entryKey(const QString &server, const QString &camera, const QString &timestamp);
+    QString filePath(const QByteArray &hash) const;
+    void insert(const Entry &entry);
+    void remove(const QString &key);
+    void touch(const QString &key);
+    void evictIfNeeded();
+    void scheduleIndexSave();
+    void saveIndex();
+    void loadIndex();
+    void sweepOrphans();
+
+    QThreadPool m_ioPool;               // 스레드 1개 - 작업이 들어온 순서대로 실행
+    QTimer *m_saveTimer;
+    QString m_directory;
+    qint64 m_quotaBytes;
+    qint64 m_totalBytes;
+
+    QHash<QString, Entry> m_entries;    // entryKey → 항목
+    QHash<QByteArray, int> m_hashRefs;  // 내용 해시 → 참조하는 항목 수
+};
+
+#endif // CAPTURECACHE_H
@@ -0,0 +1,83 @@
+#include "CaptureGalleryModel.h"
+#include "ThumbnailCache.h"
+
+CaptureGalleryModel::CaptureGalleryModel(ThumbnailCache *thumbnails, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_thumbnails(thumbnails)
+{
+    connect(m_thumbnails, &ThumbnailCache::thumbnailReady, this, &CaptureGalleryModel::onThumbnailReady);
+}
+
+int CaptureGalleryModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_images.size();
+}
+
+QVariant CaptureGalleryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_images.size()) {
+        return QVariant();
+    }
+
+    const ImageData &image = m_images.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return image.timestamp;
+    case Qt::ToolTipRole:
+        return image.logText;
+    case Qt::DecorationRole:
+        // 뷰가 그리려는 칸만 여기까지 오므로 디코드도 보이는 칸에 대해서만 예약됨
+        // (실패한 이미지는 다시 예약하지 않음 - 갱신 → 재디코드 반복 방지)
+        if (m_failedKeys.contains(ThumbnailCache::keyFor(image))) {
+            return QVariant();
+        }
+        return m_thumbnails->thumbnail(image);
+    case ThumbnailStateRole:
+        if (m_failedKeys.contains(ThumbnailCache::keyFor(image))) {
+            return static_cast<int>(ThumbnailState::Failed);
+        }
+        return static_cast<int>(m_thumbnails->thumbnail(image).isNull() ? ThumbnailState::Loading
+                                                                        : ThumbnailState::Ready);
+    default:
+        return QVariant();
+    }
+}
+
+void CaptureGalleryModel::setImages(const QList<ImageData> &images)
+{
+    beginResetModel();
+    m_images = images;
+    m_rowsByKey.clear();
+    m_failedKeys.clear();
+    for (int row = 0; row < m_images.size(); ++row) {
+        m_rowsByKey.insert(ThumbnailCache::keyFor(m_images.at(row)), row);
+    }
+    endResetModel();
+}
+
+void CaptureGalleryModel::append(const ImageData &image)
+{
+    const int row = m_images.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_images.append(image);
+    m_rowsByKey.insert(ThumbnailCache::keyFor(image), row);
+    endInsertRows();
+}
+
+void CaptureGalleryModel::clear()
+{
+    setImages(QList<ImageData>());
+}
+
+void CaptureGalleryModel::onThumbnailReady(const QByteArray &key, const QPixmap &pixmap)
+{
+    if (pixmap.isNull()) {
+        m_failedKeys.insert(key);
+    }
+
+    const QList<int> rows = m_rowsByKey.values(key);
+    for (int row : rows) {
+        const QModelIndex changed = index(row);
+        emit dataChanged(changed, changed, { Qt::DecorationRole, ThumbnailStateRole });
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef CAPTUREGALLERYMODEL_H
+#define CAPTUREGALLERYMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QList>
+#include <QMultiHash>
+#include <QSet>
+
+#include "TcpCommunicator.h"
+
+class ThumbnailCache;
+
+// 캡처 갤러리 모델
+// 위젯을 캡처마다 만들지 않고 뷰가 화면에 보이는 칸만 data() 로 물어보므로
+// 썸네일 디코드도 보이는 칸에 대해서만 예약된다.
+class CaptureGalleryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        ThumbnailStateRole = Qt::UserRole + 1     // int(ThumbnailState)
+    };
+
+    enum class ThumbnailState {
+        Loading,
+        Ready,
+        Failed
+    };
+
+    explicit CaptureGalleryModel(ThumbnailCache *thumbnails, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    const ImageData &imageAt(int row) const { return m_images.at(row); }
+
+    void setImages(const QList<ImageData> &images);
+    void append(const ImageData &image);
+    void clear();
+
+private slots:
+    void onThumbnailReady(const QByteArray &key, const QPixmap &pixmap);
+
+private:
+    ThumbnailCache *m_thumbnails;
+    QList<ImageData> m_images;
+    QMultiHash<QByteArray, int> m_rowsByKey;    // 썸네일 키 → 행 (도착 시 해당 칸만 갱신)
+    QSet<QByteArray> m_failedKeys;
+};
+
+#endif // CAPTUREGALLERYMODEL_H
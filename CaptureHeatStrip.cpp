@@ -0,0 +1,116 @@
+#include "CaptureHeatStrip.h"
+#include <QHelpEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const int kHours = 24;
+const QColor kEmptyColor("#383A41");
+const QColor kHotColor("#f37321");
+const QColor kUnknownColor("#2c2c2c");
+}
+
+CaptureHeatStrip::CaptureHeatStrip(QWidget *parent)
+    : QWidget(parent)
+    , m_maxCount(0)
+    , m_currentHour(-1)
+{
+    setCursor(Qt::PointingHandCursor);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+QSize CaptureHeatStrip::sizeHint() const
+{
+    return QSize(480, 18);
+}
+
+void CaptureHeatStrip::setCounts(const QList<int> &counts)
+{
+    m_counts = counts.mid(0, kHours);
+    m_maxCount = m_counts.isEmpty() ? 0 : *std::max_element(m_counts.cbegin(), m_counts.cend());
+    update();
+}
+
+void CaptureHeatStrip::setCurrentHour(int hour)
+{
+    m_currentHour = hour;
+    update();
+}
+
+QColor CaptureHeatStrip::heatColor(int count, int maxCount)
+{
+    if (count <= 0 || maxCount <= 0) {
+        return kEmptyColor;
+    }
+
+    // 건수 편차가 크므로 로그 스케일 (1건도 눈에 보이도록 최소 25%)
+    const double ratio = 0.25 + 0.75 * std::log1p(count) / std::log1p(maxCount);
+    return QColor::fromRgbF(kEmptyColor.redF() + (kHotColor.redF() - kEmptyColor.redF()) * ratio,
+                            kEmptyColor.greenF() + (kHotColor.greenF() - kEmptyColor.greenF()) * ratio,
+                            kEmptyColor.blueF() + (kHotColor.blueF() - kEmptyColor.blueF()) * ratio);
+}
+
+QRectF CaptureHeatStrip::cellRect(int hour) const
+{
+    const double cellWidth = double(width()) / kHours;
+    return QRectF(hour * cellWidth, 0, cellWidth, height()).adjusted(1, 1, -1, -1);
+}
+
+int CaptureHeatStrip::hourAt(const QPoint &pos) const
+{
+    if (width() <= 0) {
+        return -1;
+    }
+    const int hour = pos.x() * kHours / width();
+    return (hour >= 0 && hour < kHours) ? hour : -1;
+}
+
+void CaptureHeatStrip::paintEvent(QPaintEvent * /*event*/)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    for (int hour = 0; hour < kHours; ++hour) {
+        const QRectF rect = cellRect(hour);
+        const QColor color = m_counts.isEmpty() ? kUnknownColor : heatColor(m_counts.value(hour), m_maxCount);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(color);
+        painter.drawRoundedRect(rect, 2, 2);
+
+        if (hour == m_currentHour) {
+            painter.setPen(QPen(Qt::white, 1.5));
+            painter.setBrush(Qt::NoBrush);
+            painter.drawRoundedRect(rect, 2, 2);
+        }
+    }
+}
+
+void CaptureHeatStrip::mousePressEvent(QMouseEvent *event)
+{
+    const int hour = hourAt(event->pos());
+    if (event->button() == Qt::LeftButton && hour >= 0) {
+        emit hourClicked(hour);
+    }
+    QWidget::mousePressEvent(event);
+}
+
+bool CaptureHeatStrip::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip) {
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        const int hour = hourAt(helpEvent->pos());
+        if (hour >= 0) {
+            const QString count = m_counts.isEmpty() ? QStringLiteral("?") : QString::number(m_counts.value(hour));
+            QToolTip::showText(helpEvent->globalPos(),
+                               QString("%1시 ~ %2시: %3건").arg(hour, 2, 10, QChar('0'))
+                                   .arg(hour + 1, 2, 10, QChar('0')).arg(count), this);
+        } else {
+            QToolTip::hideText();
+        }
+        return true;
+    }
+    return QWidget::event(event);
+}
@@ -0,0 +1,44 @@
+#ifndef CAPTUREHEATSTRIP_H
+#define CAPTUREHEATSTRIP_H
+
+#include <QWidget>
+#include <QList>
+#include <QColor>
+
+// 하루 24시간의 캡처 건수를 가로 띠로 표시 (건수가 많을수록 진한 주황)
+// 칸을 누르면 그 시간을 선택한다. 건수가 0 인 시간은 흐리게 표시.
+class CaptureHeatStrip : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureHeatStrip(QWidget *parent = nullptr);
+
+    // 24개 (시간별 건수). 비어 있으면 "모름" 상태로 회색 표시
+    void setCounts(const QList<int> &counts);
+    const QList<int> &counts() const { return m_counts; }
+    void setCurrentHour(int hour);
+
+    // 달력 칸 등 다른 곳에서도 같은 색을 쓰도록
+    static QColor heatColor(int count, int maxCount);
+
+    QSize sizeHint() const override;
+
+signals:
+    void hourClicked(int hour);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    bool event(QEvent *event) override;
+
+private:
+    int hourAt(const QPoint &pos) const;
+    QRectF cellRect(int hour) const;
+
+    QList<int> m_counts;
+    int m_maxCount;
+    int m_currentHour;
+};
+
+#endif // CAPTUREHEATSTRIP_H
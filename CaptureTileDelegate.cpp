@@ -0,0 +1,65 @@
+#include "CaptureTileDelegate.h"
+#include "CaptureGalleryModel.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QPixmap>
+
+namespace {
+const QColor kCardColor("#383A41");
+const QColor kHoverBorderColor("#f37321");
+const QColor kPlaceholderColor("#999999");
+const int kTimeBarHeight = 28;
+}
+
+CaptureTileDelegate::CaptureTileDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+QSize CaptureTileDelegate::sizeHint(const QStyleOptionViewItem &/*option*/, const QModelIndex &/*index*/) const
+{
+    return QSize(TileWidth, TileHeight);
+}
+
+void CaptureTileDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
+    const QRect card = option.rect.adjusted(1, 1, -1, -1);
+    QPainterPath cardPath;
+    cardPath.addRoundedRect(card, 10, 10);
+    painter->fillPath(cardPath, kCardColor);
+    if (option.state & QStyle::State_MouseOver) {
+        painter->setPen(QPen(kHoverBorderColor, 2));
+        painter->drawPath(cardPath);
+    }
+
+    // 이미지 영역 (가운데 정렬, 비율 유지)
+    const QRect imageRect(card.left() + (card.width() - ImageWidth) / 2,
+                          card.top() + 5, ImageWidth, ImageHeight);
+    const QPixmap thumbnail = index.data(Qt::DecorationRole).value<QPixmap>();
+    if (!thumbnail.isNull()) {
+        const QSize size = thumbnail.size().scaled(imageRect.size(), Qt::KeepAspectRatio);
+        const QRect target(imageRect.left() + (imageRect.width() - size.width()) / 2,
+                           imageRect.top() + (imageRect.height() - size.height()) / 2,
+                           size.width(), size.height());
+        painter->drawPixmap(target, thumbnail);
+    } else {
+        const auto state = static_cast<CaptureGalleryModel::ThumbnailState>(
+            index.data(CaptureGalleryModel::ThumbnailStateRole).toInt());
+        painter->setPen(kPlaceholderColor);
+        painter->drawText(imageRect, Qt::AlignCenter,
+                          state == CaptureGalleryModel::ThumbnailState::Failed ? "이미지 로드 실패" : "Loading...");
+    }
+
+    // 시간 라벨
+    const QRect timeRect(card.left(), card.bottom() - kTimeBarHeight, card.width(), kTimeBarHeight);
+    QFont font = option.font;
+    font.setPixelSize(12);
+    painter->setFont(font);
+    painter->setPen(Qt::white);
+    painter->drawText(timeRect, Qt::AlignCenter, index.data(Qt::DisplayRole).toString());
+
+    painter->restore();
+}
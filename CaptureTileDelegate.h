@@ -0,0 +1,24 @@
+#ifndef CAPTURETILEDELEGATE_H
+#define CAPTURETILEDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+// 캡처 갤러리 칸 하나 (썸네일 + 타임스탬프)
+// 기존 위젯 타일(320x240 카드, 300x200 이미지, 아래 시간 라벨)과 같은 모양을 직접 그린다.
+class CaptureTileDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    static constexpr int TileWidth = 320;
+    static constexpr int TileHeight = 240;
+    static constexpr int ImageWidth = 300;
+    static constexpr int ImageHeight = 200;
+
+    explicit CaptureTileDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+};
+
+#endif // CAPTURETILEDELEGATE_H
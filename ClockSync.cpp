@@ -0,0 +1,66 @@
+#include "ClockSync.h"
+#include <QDateTime>
+#include <chrono>
+
+namespace {
+const int kWindowSize = 8;
+}
+
+ClockSync::ClockSync()
+    : m_smoothedRttUs(0)
+    , m_rttVarUs(0)
+    , m_sampleCount(0)
+{
+}
+
+qint64 ClockSync::monotonicUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void ClockSync::addSample(qint64 t0LocalUs, qint64 t1ServerUs, qint64 t2ServerUs, qint64 t3LocalUs)
+{
+    const qint64 rtt = qMax<qint64>(0, (t3LocalUs - t0LocalUs) - (t2ServerUs - t1ServerUs));
+    const qint64 offset = ((t1ServerUs - t0LocalUs) + (t2ServerUs - t3LocalUs)) / 2;
+
+    m_samples.append({ offset, rtt });
+    while (m_samples.size() > kWindowSize) {
+        m_samples.removeFirst();
+    }
+
+    // RFC 6298 와 같은 평활 (alpha 1/8, beta 1/4)
+    if (m_sampleCount == 0) {
+        m_smoothedRttUs = rtt;
+        m_rttVarUs = rtt / 2;
+    } else {
+        m_rttVarUs = (3 * m_rttVarUs + qAbs(m_smoothedRttUs - rtt)) / 4;
+        m_smoothedRttUs = (7 * m_smoothedRttUs + rtt) / 8;
+    }
+    ++m_sampleCount;
+}
+
+void ClockSync::reset()
+{
+    m_samples.clear();
+    m_smoothedRttUs = 0;
+    m_rttVarUs = 0;
+    m_sampleCount = 0;
+}
+
+qint64 ClockSync::offsetUs() const
+{
+    if (m_samples.isEmpty()) {
+        // 추정 전: 시스템 시계가 서버와 같다고 가정
+        return QDateTime::currentMSecsSinceEpoch() * 1000 - monotonicUs();
+    }
+
+    // 큐잉 지연이 가장 적었던 교환이 가장 정확 (지연이 대칭에 가까움)
+    const Sample *best = &m_samples.first();
+    for (const Sample &sample : m_samples) {
+        if (sample.rttUs < best->rttUs) {
+            best = &sample;
+        }
+    }
+    return best->offsetUs;
+}
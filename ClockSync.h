@@ -0,0 +1,52 @@
+#ifndef CLOCKSYNC_H
+#define CLOCKSYNC_H
+
+#include <QList>
+#include <QtGlobal>
+
+// 서버 시계(에포크 us)와 이 PC 의 단조 시계 사이의 차이와 왕복 시간 추정 (NTP 방식)
+//
+//   t0 = 요청 보낸 로컬 시각, t1 = 서버 수신, t2 = 서버 송신, t3 = 응답 받은 로컬 시각
+//   rtt    = (t3 - t0) - (t2 - t1)
+//   offset = ((t1 - t0) + (t2 - t3)) / 2        (서버 시각 = 로컬 단조 시각 + offset)
+//
+// 최근 표본 중 rtt 가 가장 짧은 것의 offset 을 쓰고 (큐잉 지연이 가장 적었던 교환),
+// rtt 는 TCP 처럼 평활 평균/편차로 유지한다.
+// 표본이 없을 때는 시스템 시계가 서버와 맞다고 가정한 값으로 동작한다.
+class ClockSync
+{
+public:
+    ClockSync();
+
+    // 프로세스 공통 단조 시계 (스레드 무관)
+    static qint64 monotonicUs();
+    static qint64 monotonicMs() { return monotonicUs() / 1000; }
+
+    void addSample(qint64 t0LocalUs, qint64 t1ServerUs, qint64 t2ServerUs, qint64 t3LocalUs);
+    void reset();
+
+    bool isValid() const { return !m_samples.isEmpty(); }
+    qint64 offsetUs() const;                // 서버 - 로컬 단조
+    qint64 roundTripUs() const { return m_smoothedRttUs; }
+    qint64 roundTripVarianceUs() const { return m_rttVarUs; }
+    int sampleCount() const { return m_sampleCount; }
+
+    // 서버 타임스탬프(에포크 ms)를 로컬 단조 시각(ms)으로
+    qint64 serverToLocalMs(qint64 serverMs) const { return serverMs + serverToLocalOffsetMs(); }
+    qint64 localToServerMs(qint64 localMs) const { return localMs - serverToLocalOffsetMs(); }
+    // 로컬 단조 - 서버 (ms)
+    qint64 serverToLocalOffsetMs() const { return -offsetUs() / 1000; }
+
+private:
+    struct Sample {
+        qint64 offsetUs;
+        qint64 rttUs;
+    };
+
+    QList<Sample> m_samples;        // 최근 표본 (창 크기 제한)
+    qint64 m_smoothedRttUs;
+    qint64 m_rttVarUs;
+    int m_sampleCount;
+};
+
+#endif // CLOCKSYNC_H
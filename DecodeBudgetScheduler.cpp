@@ -0,0 +1,97 @@
+#include "DecodeBudgetScheduler.h"
+#include <QDebug>
+
+namespace {
+const qint64 kDefaultFullCost = qint64(1920) * 1080 * 25;   // 측정 전 가정치
+const int kSubstreamDivisor = 4;                            // 서브 스트림은 보통 1/4 해상도
+const qint64 kSnapshotAttachMs = 1000;                      // 한 장 받는 동안 세션이 열려 있는 대략의 시간 (접속 + 첫 키프레임)
+const int kRebalanceIntervalMs = 2000;
+}
+
+DecodeBudgetScheduler::DecodeBudgetScheduler(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_maxFullRateTiles(4)
+    , m_pixelBudget(250LL * 1000 * 1000)    // 250 Mpx/s ≈ 1080p30 네 개
+    , m_snapshotIntervalMs(5000)
+{
+    // 측정값이 1초 단위로 바뀌므로 그보다 느리게 - 모드가 자주 뒤집히지 않게
+    m_timer->setInterval(kRebalanceIntervalMs);
+    connect(m_timer, &QTimer::timeout, this, &DecodeBudgetScheduler::rebalance);
+}
+
+void DecodeBudgetScheduler::setTiles(const QList<CameraTile *> &tiles)
+{
+    m_tiles.clear();
+    for (CameraTile *tile : tiles) {
+        m_tiles.append(tile);
+    }
+    if (!m_tiles.isEmpty() && (!m_focusedTile || !tiles.contains(m_focusedTile.data()))) {
+        m_focusedTile = tiles.first();
+    }
+    rebalance();
+}
+
+void DecodeBudgetScheduler::setFocusedTile(CameraTile *tile)
+{
+    if (m_focusedTile == tile) {
+        return;
+    }
+    m_focusedTile = tile;
+    rebalance();
+}
+
+void DecodeBudgetScheduler::start()
+{
+    m_timer->start();
+    rebalance();
+}
+
+void DecodeBudgetScheduler::stop()
+{
+    m_timer->stop();
+}
+
+qint64 DecodeBudgetScheduler::fullCostOf(const CameraTile *tile)
+{
+    return tile->fullRatePixelRate() > 0 ? tile->fullRatePixelRate() : kDefaultFullCost;
+}
+
+void DecodeBudgetScheduler::rebalance()
+{
+    // 선택된 칸이 항상 먼저
+    QList<CameraTile *> order;
+    if (m_focusedTile) {
+        order.append(m_focusedTile);
+    }
+    for (const QPointer<CameraTile> &tile : std::as_const(m_tiles)) {
+        if (tile && tile != m_focusedTile) {
+            order.append(tile);
+        }
+    }
+
+    qint64 planned = 0;
+    qint64 measured = 0;
+    int fullCount = 0;
+    for (CameraTile *tile : std::as_const(order)) {
+        tile->setFocused(tile == m_focusedTile);
+
+        const qint64 fullCost = fullCostOf(tile);
+        const bool focused = tile == m_focusedTile;
+        if (focused || (fullCount < m_maxFullRateTiles && planned + fullCost <= m_pixelBudget)) {
+            tile->setDecodeMode(CameraTile::DecodeMode::Full, m_snapshotIntervalMs);
+            planned += fullCost;
+            ++fullCount;
+        } else if (tile->hasSubstream()) {
+            tile->setDecodeMode(CameraTile::DecodeMode::Substream, m_snapshotIntervalMs);
+            planned += fullCost / kSubstreamDivisor;
+        } else {
+            // 서브 스트림이 없으면 세션에서 빠지고 주기적으로 한 장만 - 그 사이에는 디코드하지 않음
+            tile->setDecodeMode(CameraTile::DecodeMode::Snapshot, m_snapshotIntervalMs);
+            planned += fullCost * kSnapshotAttachMs / qMax<qint64>(kSnapshotAttachMs, m_snapshotIntervalMs);
+        }
+        measured += tile->currentPixelRate();
+    }
+
+    emit rebalanced(planned, measured, m_pixelBudget);
+}
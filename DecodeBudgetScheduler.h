@@ -0,0 +1,53 @@
+#ifndef DECODEBUDGETSCHEDULER_H
+#define DECODEBUDGETSCHEDULER_H
+
+#include <QObject>
+#include <QList>
+#include <QPointer>
+#include <QTimer>
+
+#include "CameraTile.h"
+
+// 멀티 카메라 그리드의 디코드 예산 배분
+// 선택된 칸을 먼저, 나머지는 칸 순서대로 원본 전체 fps(Full)를 주고,
+// 최대 칸 수나 초당 픽셀 예산을 넘는 칸은 서브 스트림(있으면) 또는 주기적 한 장(Snapshot)으로 내린다.
+// 비용은 칸이 측정한 원본 해상도 x fps 를 쓰고, 아직 모르면 1080p 25fps 로 가정한다.
+// Snapshot 은 세션에서 빠져 있다가 주기마다 잠깐만 붙으므로, 붙어 있는 시간 비율만큼만 센다.
+class DecodeBudgetScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DecodeBudgetScheduler(QObject *parent = nullptr);
+
+    void setTiles(const QList<CameraTile *> &tiles);
+    void setFocusedTile(CameraTile *tile);
+    CameraTile *focusedTile() const { return m_focusedTile; }
+
+    void setMaxFullRateTiles(int count) { m_maxFullRateTiles = count; }
+    void setPixelBudget(qint64 pixelsPerSecond) { m_pixelBudget = pixelsPerSecond; }
+    void setSnapshotIntervalMs(int intervalMs) { m_snapshotIntervalMs = intervalMs; }
+    qint64 pixelBudget() const { return m_pixelBudget; }
+
+    void start();
+    void stop();
+
+public slots:
+    void rebalance();
+
+signals:
+    // 예산 배분 결과 (계획 픽셀/초, 실제 측정 픽셀/초)
+    void rebalanced(qint64 plannedPixelRate, qint64 measuredPixelRate, qint64 budget);
+
+private:
+    static qint64 fullCostOf(const CameraTile *tile);
+
+    QList<QPointer<CameraTile>> m_tiles;
+    QPointer<CameraTile> m_focusedTile;
+    QTimer *m_timer;
+    int m_maxFullRateTiles;
+    qint64 m_pixelBudget;
+    int m_snapshotIntervalMs;
+};
+
+#endif // DECODEBUDGETSCHEDULER_H
@@ -0,0 +1,150 @@
+#include "FrameDecoder.h"
+#include <QIODevice>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+const qsizetype kInitialCapacity = 64 * 1024;          // 64KB
+const qsizetype kShrinkThreshold = 4 * 1024 * 1024;    // 큰 이미지 프레임 이후 메모리 반환 기준
+}
+
+FrameDecoder::FrameDecoder(qsizetype maxFrameSize)
+    : m_readPos(0)
+    , m_writePos(0)
+    , m_maxFrameSize(maxFrameSize)
+    , m_pendingLength(0)
+{
+}
+
+void FrameDecoder::setMaxFrameSize(qsizetype maxFrameSize)
+{
+    m_maxFrameSize = maxFrameSize;
+}
+
+void FrameDecoder::reset()
+{
+    m_buffer = QByteArray();
+    m_readPos = 0;
+    m_writePos = 0;
+    m_pendingLength = 0;
+}
+
+QByteArray FrameDecoder::takePendingFrame(quint32 &frameLength)
+{
+    frameLength = m_pendingLength;
+    if (bufferedBytes() < HeaderSize) {
+        frameLength = 0;
+        return QByteArray();
+    }
+
+    // NeedMoreData 직후이므로 버퍼에는 이 프레임의 앞부분만 남아 있다
+    const QByteArray prefix(m_buffer.constData() + m_readPos + HeaderSize, bufferedBytes() - HeaderSize);
+    m_readPos = 0;
+    m_writePos = 0;
+    m_pendingLength = 0;
+    return prefix;
+}
+
+void FrameDecoder::reserveTail(qsizetype bytes)
+{
+    if (m_buffer.size() - m_writePos >= bytes) {
+        return;
+    }
+
+    // 1. 이미 처리한 앞부분을 버리고 남은 (미완성) 데이터만 앞으로 당긴다
+    const qsizetype unread = m_writePos - m_readPos;
+    if (m_readPos > 0) {
+        if (unread > 0) {
+            std::memmove(m_buffer.data(), m_buffer.constData() + m_readPos, static_cast<size_t>(unread));
+        }
+        m_readPos = 0;
+        m_writePos = unread;
+    }
+
+    // 2. 그래도 부족하면 버퍼 확장
+    if (m_buffer.size() - m_writePos < bytes) {
+        qsizetype newSize = qMax(m_buffer.size() * 2, kInitialCapacity);
+        while (newSize - m_writePos < bytes) {
+            newSize *= 2;
+        }
+        m_buffer.resize(newSize);
+    }
+}
+
+qint64 FrameDecoder::readFrom(QIODevice *device)
+{
+    if (!device) {
+        return 0;
+    }
+
+    const qint64 available = device->bytesAvailable();
+    if (available <= 0) {
+        return 0;
+    }
+
+    // 버퍼가 비었고 큰 프레임 때문에 커져 있다면 메모리 반환
+    if (bufferedBytes() == 0) {
+        m_readPos = 0;
+        m_writePos = 0;
+        if (m_buffer.size() > kShrinkThreshold) {
+            m_buffer = QByteArray();
+        }
+    }
+
+    // 길이를 이미 알고 있는 프레임은 한 번에 전체 크기를 확보해 재할당을 줄인다
+    qsizetype wanted = static_cast<qsizetype>(available);
+    if (m_pendingLength > 0) {
+        const qsizetype remaining = HeaderSize + m_pendingLength - bufferedBytes();
+        wanted = qMax(wanted, remaining);
+    }
+    reserveTail(wanted);
+
+    const qint64 bytesRead = device->read(m_buffer.data() + m_writePos, available);
+    if (bytesRead > 0) {
+        m_writePos += bytesRead;
+    }
+    return bytesRead;
+}
+
+void FrameDecoder::append(QByteArrayView data)
+{
+    if (data.isEmpty()) {
+        return;
+    }
+    reserveTail(data.size());
+    std::memcpy(m_buffer.data() + m_writePos, data.data(), static_cast<size_t>(data.size()));
+    m_writePos += data.size();
+}
+
+FrameDecoder::Status FrameDecoder::nextFrame(QByteArrayView &frame)
+{
+    if (bufferedBytes() < HeaderSize) {
+        return Status::NeedMoreData;
+    }
+
+    // 길이 헤더를 버퍼 안에서 바로 해석 (QDataStream/복사 없음)
+    const uchar *header = reinterpret_cast<const uchar *>(m_buffer.constData() + m_readPos);
+    m_pendingLength = qFromBigEndian<quint32>(header);
+
+    if (static_cast<qsizetype>(m_pendingLength) > m_maxFrameSize) {
+        qDebug() << "[Frame] Frame too large:" << m_pendingLength << "bytes, limit:" << m_maxFrameSize;
+        return Status::FrameTooLarge;
+    }
+
+    if (bufferedBytes() < HeaderSize + static_cast<qsizetype>(m_pendingLength)) {
+        return Status::NeedMoreData;
+    }
+
+    frame = QByteArrayView(m_buffer.constData() + m_readPos + HeaderSize, m_pendingLength);
+    m_readPos += HeaderSize + m_pendingLength;
+    m_pendingLength = 0;
+
+    if (m_readPos == m_writePos) {
+        // 남은 데이터가 없으면 커서만 되돌린다 (메모리 이동 없음)
+        m_readPos = 0;
+        m_writePos = 0;
+    }
+
+    return Status::FrameReady;
+}
@@ -0,0 +1,56 @@
+#ifndef FRAMEDECODER_H
+#define FRAMEDECODER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+class QIODevice;
+
+// 4바이트 빅엔디안 길이 + 페이로드 형식의 프레임 디코더
+// 연결(TcpCommunicator 인스턴스)마다 하나씩 두고, 연결이 끊기면 reset()으로 비운다.
+class FrameDecoder
+{
+public:
+    enum class Status {
+        NeedMoreData,   // 완전한 프레임이 아직 도착하지 않음
+        FrameReady,     // frame 에 완성된 프레임이 담김
+        FrameTooLarge   // 길이 헤더가 최대 크기를 초과함 (연결을 끊어야 함)
+    };
+
+    static constexpr qsizetype HeaderSize = 4;
+    static constexpr qsizetype DefaultMaxFrameSize = 64 * 1024 * 1024; // 64MB
+
+    explicit FrameDecoder(qsizetype maxFrameSize = DefaultMaxFrameSize);
+
+    // 소켓에 도착한 바이트를 내부 버퍼 끝에 바로 읽어 들인다 (readAll() 임시 버퍼 없음)
+    qint64 readFrom(QIODevice *device);
+    void append(QByteArrayView data);
+
+    // 다음 프레임을 꺼낸다. frame 은 내부 버퍼를 가리키는 뷰이며
+    // 다음 readFrom()/append()/reset() 호출 전까지만 유효하다.
+    Status nextFrame(QByteArrayView &frame);
+
+    void reset();
+
+    // 길이를 아는 미완성 프레임을 꺼낸다 (큰 프레임을 호출자가 직접 이어 읽을 때 사용).
+    // 지금까지 버퍼에 도착한 페이로드를 돌려주고 디코더는 빈 상태가 된다.
+    // nextFrame() 이 NeedMoreData 를 돌려준 직후에만 호출한다.
+    QByteArray takePendingFrame(quint32 &frameLength);
+
+    void setMaxFrameSize(qsizetype maxFrameSize);
+    qsizetype maxFrameSize() const { return m_maxFrameSize; }
+
+    qsizetype bufferedBytes() const { return m_writePos - m_readPos; }
+    quint32 pendingFrameLength() const { return m_pendingLength; }
+
+private:
+    void reserveTail(qsizetype bytes);
+
+    QByteArray m_buffer;
+    qsizetype m_readPos;
+    qsizetype m_writePos;
+    qsizetype m_maxFrameSize;
+    quint32 m_pendingLength;
+};
+
+#endif // FRAMEDECODER_H
@@ -0,0 +1,216 @@
+#include "HourPrefetcher.h"
+#include "ThumbnailCache.h"
+#include <QDateTime>
+#include <QDebug>
+
+namespace {
+const int kIdleDelayMs = 300;
+const qint64 kMaxPageAgeMs = 2 * 60 * 1000;
+}
+
+HourPrefetcher::HourPrefetcher(ThumbnailCache *thumbnails, QObject *parent)
+    : QObject(parent)
+    , m_thumbnails(thumbnails)
+    , m_idleTimer(new QTimer(this))
+    , m_pageSize(0)
+    , m_detail(TcpCommunicator::ImageDetail::Thumbnail)
+    , m_storedBytes(0)
+    , m_budgetBytes(16 * 1024 * 1024)    // 16MB
+{
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(kIdleDelayMs);
+    connect(m_idleTimer, &QTimer::timeout, this, &HourPrefetcher::startNext);
+}
+
+void HourPrefetcher::setTcpCommunicator(TcpCommunicator *communicator)
+{
+    if (m_tcpCommunicator) {
+        disconnect(m_tcpCommunicator, nullptr, this, nullptr);
+    }
+    stop();
+    clear();
+
+    m_tcpCommunicator = communicator;
+    if (m_tcpCommunicator) {
+        connect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                this, &HourPrefetcher::onConnectionStateChanged);
+    }
+}
+
+QString HourPrefetcher::keyFor(const QDate &date, int hour)
+{
+    return QString("%1|%2").arg(date.toString(Qt::ISODate)).arg(hour);
+}
+
+qint64 HourPrefetcher::pageBytes(const Page &page)
+{
+    qint64 bytes = 0;
+    for (const ImageData &image : page.images) {
+        bytes += image.encodedData.size();
+    }
+    return bytes;
+}
+
+void HourPrefetcher::prefetchAround(const QDate &date, int hour, int pageSize, TcpCommunicator::ImageDetail detail,
+                                    const QList<int> &hourCounts)
+{
+    m_pageSize = pageSize;
+    m_detail = detail;
+
+    // 다른 시간대로 옮겼으면 예전 예약은 의미가 없음
+    m_queue.clear();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int neighbour : { hour + 1, hour - 1 }) {
+        if (neighbour < 0 || neighbour > 23) {
+            continue;
+        }
+        if (!hourCounts.isEmpty() && hourCounts.value(neighbour) == 0) {
+            continue;
+        }
+        const auto stored = m_pages.constFind(keyFor(date, neighbour));
+        if ((stored != m_pages.cend() && now - stored->fetchedMs <= kMaxPageAgeMs) ||
+            (m_activeRequest && m_activeJob.date == date && m_activeJob.hour == neighbour)) {
+            continue;
+        }
+        m_queue.append({ date, neighbour });
+    }
+
+    schedule();
+}
+
+bool HourPrefetcher::take(const QDate &date, int hour, Page &page)
+{
+    const QString key = keyFor(date, hour);
+    auto it = m_pages.find(key);
+    if (it == m_pages.end()) {
+        return false;
+    }
+
+    page = it.value();
+    m_storedBytes -= pageBytes(page);
+    m_pages.erase(it);
+    m_pageOrder.removeOne(key);
+    return QDateTime::currentMSecsSinceEpoch() - page.fetchedMs <= kMaxPageAgeMs;
+}
+
+void HourPrefetcher::yieldToForeground()
+{
+    // 진행 중인 미리 받기는 취소하고 큐 앞으로 되돌림 - 사용자 요청이 끝난 뒤 다시 시도
+    if (m_activeRequest && m_activeRequest->isPending()) {
+        m_queue.prepend(m_activeJob);
+        m_activeRequest->cancel();
+    }
+    m_activeRequest = nullptr;
+    schedule();
+}
+
+void HourPrefetcher::stop()
+{
+    m_idleTimer->stop();
+    m_queue.clear();
+    if (m_activeRequest) {
+        m_activeRequest->cancel();
+    }
+    m_activeRequest = nullptr;
+}
+
+void HourPrefetcher::clear()
+{
+    m_pages.clear();
+    m_pageOrder.clear();
+    m_storedBytes = 0;
+}
+
+void HourPrefetcher::onConnectionStateChanged(TcpCommunicator::ConnectionState state)
+{
+    if (state != TcpCommunicator::ConnectionState::Ready) {
+        stop();
+    }
+}
+
+void HourPrefetcher::schedule()
+{
+    if (!m_queue.isEmpty()) {
+        m_idleTimer->start();
+    }
+}
+
+void HourPrefetcher::startNext()
+{
+    if (m_queue.isEmpty() || (m_activeRequest && m_activeRequest->isPending()) || !m_tcpCommunicator ||
+        !m_tcpCommunicator->isConnectedToServer()) {
+        return;
+    }
+
+    // 사용자 요청이나 보낼 데이터가 남아 있으면 양보하고 나중에 다시
+    if (m_tcpCommunicator->pendingRequestCount() > 0 || m_tcpCommunicator->pendingWriteBytes() > 0) {
+        m_idleTimer->start();
+        return;
+    }
+
+    const Job job = m_queue.takeFirst();
+    // 사용자가 열지 않은 시간대이므로 상태 표시/갤러리 시그널이 없는 경로로
+    PendingRequest *request = m_tcpCommunicator->prefetchImagePage(job.date.toString("yyyy-MM-dd"), job.hour,
+                                                                   QString(), m_pageSize, m_detail);
+    if (!request) {
+        schedule();
+        return;
+    }
+
+    m_activeJob = job;
+    m_activeRequest = request;
+    qDebug() << "[Prefetch] 시작:" << job.date << job.hour << "시";
+
+    connect(request, &PendingRequest::finished, this, [this, request, job]() {
+        Page page;
+        page.images = request->images();
+        page.cursor = request->nextCursor();
+        page.hasMore = request->hasMore();
+        page.fetchedMs = QDateTime::currentMSecsSinceEpoch();
+        store(keyFor(job.date, job.hour), page);
+
+        // 썸네일 캐시에 여유가 있으면 디코드까지 미리 (한도의 절반까지만 사용)
+        if (m_thumbnails->usedBytes() < m_thumbnails->budgetBytes() / 2) {
+            for (const ImageData &image : page.images) {
+                m_thumbnails->thumbnail(image);
+            }
+        }
+
+        qDebug() << "[Prefetch] 완료:" << job.date << job.hour << "시 -" << page.images.size() << "개";
+        m_activeRequest = nullptr;
+        schedule();
+    });
+    // 실패한 시간대는 다시 시도하지 않고 다음 것으로 (끊긴 경우는 onConnectionStateChanged 에서 멈춤)
+    connect(request, &PendingRequest::timedOut, this, [this, job]() {
+        qDebug() << "[Prefetch] 타임아웃:" << job.date << job.hour << "시";
+        m_activeRequest = nullptr;
+        schedule();
+    });
+    connect(request, &PendingRequest::failed, this, [this, job](const QString &reason) {
+        qDebug() << "[Prefetch] 실패:" << job.date << job.hour << "시 -" << reason;
+        m_activeRequest = nullptr;
+        schedule();
+    });
+}
+
+void HourPrefetcher::store(const QString &key, const Page &page)
+{
+    const qint64 bytes = pageBytes(page);
+    if (bytes > m_budgetBytes) {
+        return;
+    }
+
+    if (m_pages.contains(key)) {
+        m_storedBytes -= pageBytes(m_pages.take(key));
+        m_pageOrder.removeOne(key);
+    }
+
+    while (!m_pageOrder.isEmpty() && m_storedBytes + bytes > m_budgetBytes) {
+        const QString oldest = m_pageOrder.takeFirst();
+        m_storedBytes -= pageBytes(m_pages.take(oldest));
+    }
+
+    m_pages.insert(key, page);
+    m_pageOrder.append(key);
+    m_storedBytes += bytes;
+}
@@ -0,0 +1,78 @@
+#ifndef HOURPREFETCHER_H
+#define HOURPREFETCHER_H
+
+#include <QObject>
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QTimer>
+
+#include "TcpCommunicator.h"
+#include "PendingRequest.h"
+
+class ThumbnailCache;
+
+// 보고 있는 시간대의 앞뒤 시간(H-1, H+1) 첫 페이지를 백그라운드로 미리 받아 둔다.
+// - 다른 요청이 대기 중이거나 송신 버퍼가 차 있으면 기다린다 (한 번에 하나씩, 유휴 시간에만)
+// - 사용자 요청이 시작되면 진행 중인 미리 받기는 취소하고 다시 줄을 세운다
+// - 연결이 끊기면 모두 멈추고, 보관량은 바이트 한도 안에서 오래된 시간대부터 버린다
+class HourPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Page {
+        QList<ImageData> images;
+        QString cursor;
+        bool hasMore = false;
+        qint64 fetchedMs = 0;            // 받은 시각 (오래된 목록은 버림 - 그 사이 캡처가 늘었을 수 있음)
+    };
+
+    HourPrefetcher(ThumbnailCache *thumbnails, QObject *parent = nullptr);
+
+    void setTcpCommunicator(TcpCommunicator *communicator);
+    void setBudget(qint64 bytes) { m_budgetBytes = bytes; }
+
+    // hour 를 보기 시작함 - 앞뒤 시간을 예약 (건수를 알면 빈 시간은 건너뜀)
+    void prefetchAround(const QDate &date, int hour, int pageSize, TcpCommunicator::ImageDetail detail,
+                        const QList<int> &hourCounts);
+    // 미리 받아 둔 첫 페이지가 있고 오래되지 않았으면 꺼낸다
+    bool take(const QDate &date, int hour, Page &page);
+
+    // 사용자 요청이 나가기 전에 호출 - 진행 중인 미리 받기를 양보
+    void yieldToForeground();
+    void stop();
+    void clear();                        // 보관 중인 페이지 버림 (서버가 바뀔 때)
+
+private slots:
+    void startNext();
+    void onConnectionStateChanged(TcpCommunicator::ConnectionState state);
+
+private:
+    struct Job {
+        QDate date;
+        int hour = -1;
+    };
+
+    static QString keyFor(const QDate &date, int hour);
+    static qint64 pageBytes(const Page &page);
+    void schedule();
+    void store(const QString &key, const Page &page);
+
+    ThumbnailCache *m_thumbnails;
+    QPointer<TcpCommunicator> m_tcpCommunicator;
+    QTimer *m_idleTimer;                 // 마지막 활동 뒤 잠깐 쉬었다가 시작
+    QList<Job> m_queue;
+    Job m_activeJob;
+    QPointer<PendingRequest> m_activeRequest;
+    int m_pageSize;
+    TcpCommunicator::ImageDetail m_detail;
+
+    QHash<QString, Page> m_pages;
+    QList<QString> m_pageOrder;          // 오래된 것부터 (한도 초과 시 앞에서 버림)
+    qint64 m_storedBytes;
+    qint64 m_budgetBytes;
+};
+
+#endif // HOURPREFETCHER_H
@@ -0,0 +1,228 @@
+#include "ImageStreamParser.h"
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <utility>
+
+namespace {
+// 처리한 앞부분이 이 크기를 넘거나 버퍼의 절반을 넘으면 버퍼를 당긴다 (작은 memmove 반복 방지)
+const qsizetype kCompactThreshold = 64 * 1024;
+
+bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+}
+
+ImageStreamParser::ImageStreamParser()
+{
+    reset();
+}
+
+void ImageStreamParser::reset()
+{
+    m_buffer = QByteArray();
+    m_scanPos = 0;
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+    m_started = false;
+    m_passthrough = false;
+    m_expectKey = false;
+    m_expectValue = false;
+    m_keyStart = -1;
+    m_key.clear();
+    m_scalarStart = -1;
+    m_inData = false;
+    m_elementStart = -1;
+    m_requestId = 0;
+    m_seq = 0;
+    m_streaming = false;
+    m_deferred = false;
+    m_elementCount = 0;
+}
+
+bool ImageStreamParser::feed(QByteArrayView data, const ElementHandler &onElement)
+{
+    m_buffer.append(data.data(), data.size());
+
+    if (m_passthrough) {
+        return true;
+    }
+    if (!scan(onElement)) {
+        return false;
+    }
+    if (m_streaming) {
+        compact();
+    }
+    return true;
+}
+
+QByteArray ImageStreamParser::takeBufferedFrame()
+{
+    QByteArray frame = std::exchange(m_buffer, QByteArray());
+    reset();
+    return frame;
+}
+
+bool ImageStreamParser::scan(const ElementHandler &onElement)
+{
+    const char *data = m_buffer.constData();
+    const qsizetype size = m_buffer.size();
+
+    for (; m_scanPos < size; ++m_scanPos) {
+        const char c = data[m_scanPos];
+
+        if (!m_started) {
+            if (isJsonSpace(c)) {
+                continue;
+            }
+            if (c != '{') {
+                // JSON 객체가 아니면 (CBOR 등) 보관만 했다가 기존 경로로 넘긴다
+                m_passthrough = true;
+                return true;
+            }
+            m_started = true;
+            m_depth = 1;
+            m_expectKey = true;
+            continue;
+        }
+
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+                if (m_keyStart >= 0) {
+                    m_key = m_buffer.mid(m_keyStart, m_scanPos - m_keyStart);
+                    m_keyStart = -1;
+                }
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '"':
+            m_inString = true;
+            if (m_depth == 1 && m_expectKey) {
+                m_expectKey = false;
+                m_keyStart = m_scanPos + 1;
+            } else if (m_depth == 1) {
+                m_expectValue = false;
+            }
+            break;
+        case ':':
+            if (m_depth == 1) {
+                m_expectValue = true;
+            }
+            break;
+        case ',':
+            if (m_depth == 1) {
+                onScalar(m_scanPos);
+                m_expectKey = true;
+                m_expectValue = false;
+            }
+            break;
+        case '{':
+        case '[':
+            if (m_depth == 1 && m_expectValue) {
+                m_expectValue = false;
+                if (c == '[' && m_key == "data") {
+                    m_inData = true;
+                    // request_id 를 아직 모르면 원소를 버릴 수 없으므로 이 프레임은 스트리밍하지 않음
+                    if (!m_streaming) {
+                        m_deferred = true;
+                    }
+                }
+            } else if (m_depth == 2 && m_inData && c == '{') {
+                m_elementStart = m_scanPos;
+            }
+            ++m_depth;
+            break;
+        case '}':
+        case ']':
+            --m_depth;
+            if (m_depth < 0) {
+                return false;
+            }
+            if (m_depth == 0) {
+                onScalar(m_scanPos);
+            } else if (m_depth == 1 && m_inData) {
+                m_inData = false;
+            } else if (m_depth == 2 && m_inData && c == '}' && m_elementStart >= 0) {
+                if (m_streaming) {
+                    // 원소 하나만 감싸서 파싱 (복사 없음)
+                    const QByteArray element = QByteArray::fromRawData(data + m_elementStart,
+                                                                       m_scanPos + 1 - m_elementStart);
+                    QJsonParseError error;
+                    const QJsonDocument doc = QJsonDocument::fromJson(element, &error);
+                    if (error.error != QJsonParseError::NoError) {
+                        qDebug() << "[Stream] 이미지 원소 파싱 오류:" << error.errorString();
+                        return false;
+                    }
+                    m_elementCount++;
+                    onElement(doc.object());
+                }
+                m_elementStart = -1;
+            }
+            break;
+        default:
+            if (m_depth == 1 && m_expectValue && !isJsonSpace(c)) {
+                // 최상위 숫자/true/false/null 값
+                m_expectValue = false;
+                m_scalarStart = m_scanPos;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+void ImageStreamParser::onScalar(qsizetype end)
+{
+    if (m_scalarStart < 0) {
+        return;
+    }
+
+    const QByteArrayView value = QByteArrayView(m_buffer.constData() + m_scalarStart, end - m_scalarStart).trimmed();
+    m_scalarStart = -1;
+
+    if (m_key == "request_id" || (m_key == "response_id" && m_requestId == 0)) {
+        m_requestId = value.toInt();
+        if (m_requestId == 10 && !m_deferred) {
+            m_streaming = true;
+        }
+    } else if (m_key == "seq") {
+        m_seq = static_cast<quint32>(value.toULongLong());
+    }
+}
+
+void ImageStreamParser::compact()
+{
+    // 아직 필요한 위치(진행 중인 원소/키/값) 앞까지는 버린다
+    qsizetype keepFrom = m_scanPos;
+    for (qsizetype anchor : { m_elementStart, m_keyStart, m_scalarStart }) {
+        if (anchor >= 0) {
+            keepFrom = qMin(keepFrom, anchor);
+        }
+    }
+
+    if (keepFrom == 0 || (keepFrom < kCompactThreshold && keepFrom * 2 < m_buffer.size())) {
+        return;
+    }
+
+    m_buffer.remove(0, keepFrom);
+    m_scanPos -= keepFrom;
+    if (m_elementStart >= 0) {
+        m_elementStart -= keepFrom;
+    }
+    if (m_keyStart >= 0) {
+        m_keyStart -= keepFrom;
+    }
+    if (m_scalarStart >= 0) {
+        m_scalarStart -= keepFrom;
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef IMAGESTREAMPARSER_H
+#define IMAGESTREAMPARSER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QJsonObject>
+#include <functional>
+
+// 큰 JSON 프레임을 도착하는 대로 훑는 증분 토크나이저 (request_id 10 이미지 응답용)
+//
+// {"request_id": 10, "seq": 3, "data": [ {...}, {...}, ... ]} 에서
+// data 배열의 원소가 하나 완성될 때마다 그 원소만 파싱해 콜백으로 넘기고, 처리한 바이트는 버린다.
+// 따라서 버퍼에는 최대 원소(이미지) 하나 분량만 남는다.
+//
+// request_id 가 data 보다 먼저 나오지 않거나 10 이 아니거나 JSON 이 아니면
+// 프레임 전체를 그대로 보관했다가 takeBufferedFrame() 으로 돌려준다 (기존 파싱 경로 사용).
+class ImageStreamParser
+{
+public:
+    using ElementHandler = std::function<void(const QJsonObject &element)>;
+
+    ImageStreamParser();
+
+    void reset();
+
+    // 새로 도착한 바이트를 넘긴다. 형식 오류면 false (나머지 바이트는 무시해야 함)
+    bool feed(QByteArrayView data, const ElementHandler &onElement);
+
+    bool isStreaming() const { return m_streaming; }
+    int requestId() const { return m_requestId; }
+    quint32 seq() const { return m_seq; }
+    int elementCount() const { return m_elementCount; }
+    qsizetype bufferedBytes() const { return m_buffer.size(); }
+
+    // 스트리밍하지 못한 프레임의 전체 바이트
+    QByteArray takeBufferedFrame();
+
+private:
+    bool scan(const ElementHandler &onElement);
+    void onScalar(qsizetype end);
+    void compact();
+
+    QByteArray m_buffer;
+    qsizetype m_scanPos;
+
+    // 토크나이저 상태
+    int m_depth;
+    bool m_inString;
+    bool m_escape;
+    bool m_started;             // 첫 '{' 확인
+    bool m_passthrough;         // JSON 객체가 아님 - 훑지 않고 보관만
+    bool m_expectKey;           // 최상위에서 다음 문자열이 키
+    bool m_expectValue;         // 최상위 ':' 다음
+    qsizetype m_keyStart;
+    QByteArray m_key;
+    qsizetype m_scalarStart;    // 최상위 숫자 값 시작 위치 (-1 이면 없음)
+    bool m_inData;              // "data" 배열 안
+    qsizetype m_elementStart;   // 현재 원소 시작 위치 (-1 이면 없음)
+
+    // 헤더 값
+    int m_requestId;
+    quint32 m_seq;
+    bool m_streaming;           // request_id 10 확인 - 원소 단위로 파싱하고 버퍼를 비움
+    bool m_deferred;            // request_id 보다 data 가 먼저 나옴 - 스트리밍 불가
+    int m_elementCount;
+};
+
+#endif // IMAGESTREAMPARSER_H
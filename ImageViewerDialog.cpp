@@ -1,18 +1,18 @@
 #include "ImageViewerDialog.h"
+#include "TiledImageView.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QScrollArea>
 #include <QApplication>
 #include <QScreen>
 #include <QKeyEvent>
 
 ImageViewerDialog::ImageViewerDialog(QWidget *parent)
     : QDialog(parent)
-    , m_imageLabel(nullptr)
+    , m_imageView(nullptr)
+    , m_zoomLabel(nullptr)
     , m_timestampLabel(nullptr)
     , m_logTextEdit(nullptr)
     , m_closeButton(nullptr)
-    , m_scrollArea(nullptr)
 {
     setupUI();
     setWindowTitle("이미지 뷰어");
@@ -48,6 +48,11 @@ void ImageViewerDialog::setupUI()
 
     headerLayout->addStretch();
 
+    m_zoomLabel = new QLabel();
+    m_zoomLabel->setStyleSheet("font-size: 12px; color: #999999; padding: 10px;");
+    m_zoomLabel->setToolTip("휠: 확대/축소, 드래그: 이동, 더블클릭: 맞춤/100%");
+    headerLayout->addWidget(m_zoomLabel);
+
     m_closeButton = new QPushButton("닫기");
     m_closeButton->setStyleSheet(R"(
         QPushButton {
@@ -66,18 +71,11 @@ void ImageViewerDialog::setupUI()
 
     mainLayout->addLayout(headerLayout);
 
-    m_scrollArea = new QScrollArea();
-    m_scrollArea->setWidgetResizable(true);
-    m_scrollArea->setAlignment(Qt::AlignCenter);
-    m_scrollArea->setStyleSheet("QScrollArea { border: none; background-color: #2e2e3a; }");
-
-    m_imageLabel = new QLabel();
-    m_imageLabel->setAlignment(Qt::AlignCenter);
-    m_imageLabel->setStyleSheet("background-color: transparent;");
-    //m_imageLabel->setScaledContents(true);  // 크기 자동 조절
-
-    m_scrollArea->setWidget(m_imageLabel);
-    mainLayout->addWidget(m_scrollArea, 3);
+    m_imageView = new TiledImageView();
+    connect(m_imageView, &TiledImageView::scaleChanged, this, [this](double scale) {
+        m_zoomLabel->setText(QString("%1%").arg(qRound(scale * 100)));
+    });
+    mainLayout->addWidget(m_imageView, 3);
 
     QLabel *logLabel = new QLabel("로그 정보:");
     logLabel->setStyleSheet("font-weight: bold; color: #ffffff; margin-top: 10px;");
@@ -98,55 +96,64 @@ void ImageViewerDialog::setupUI()
     setLayout(mainLayout);
 }
 
-void ImageViewerDialog::setImage(const QPixmap &pixmap, const QString &timestamp, const QString &logText)
+void ImageViewerDialog::setImage(const QImage &image, const QString &timestamp, const QString &logText)
 {
-    if (!pixmap.isNull()) {
-        // 1. 화면 크기 정보 가져오기
-        QScreen *screen = QApplication::primaryScreen();
-        QRect screenGeometry = screen->availableGeometry();
-
-        const int screenMaxWidth = screenGeometry.width() * 0.7;
-        const int screenMaxHeight = screenGeometry.height() * 0.7;
-        const int minWidth = 640;
-        const int minHeight = 360;
-
-        // 2. 이미지 크기 조절
-        QSize originalSize = pixmap.size();
-        QSize scaledSize = originalSize;
-
-        scaledSize.scale(screenMaxWidth, screenMaxHeight, Qt::KeepAspectRatio);
-
-        // 최소 크기 보장
-        if (scaledSize.width() < minWidth || scaledSize.height() < minHeight) {
-            scaledSize.setWidth(std::max(scaledSize.width(), minWidth));
-            scaledSize.setHeight(std::max(scaledSize.height(), minHeight));
-        }
+    m_imageView->setImage(image);
+    resizeToImage(image.size());
+    setDetails(timestamp, logText);
+}
 
-        QPixmap scaledPixmap = pixmap.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+void ImageViewerDialog::setEncodedImage(const QByteArray &encodedData, const QString &timestamp, const QString &logText)
+{
+    m_imageView->setEncodedImage(encodedData);
+    resizeToImage(m_imageView->imageSize());
+    setDetails(timestamp, logText);
+}
 
-        // 3. 이미지 적용
-        m_imageLabel->setPixmap(scaledPixmap);
-        m_imageLabel->resize(scaledPixmap.size());
+void ImageViewerDialog::setDetails(const QString &timestamp, const QString &logText)
+{
+    m_timestampLabel->setText(QString("촬영 시간: %1").arg(timestamp));
+    m_logTextEdit->setPlainText(logText);
+}
 
-        // 4. 창 크기 동적으로 조정
-        const int headerHeight = 60; // 타이틀 + 버튼 여유
-        const int logAreaHeight = 180; // 로그 영역 여유
-        const int margin = 40;
+void ImageViewerDialog::resizeToImage(const QSize &imageSize)
+{
+    // 1. 화면 크기 정보 가져오기
+    QScreen *screen = QApplication::primaryScreen();
+    QRect screenGeometry = screen->availableGeometry();
 
-        int dialogWidth = scaledSize.width() + margin;
-        int dialogHeight = scaledSize.height() + headerHeight + logAreaHeight;
+    const int screenMaxWidth = screenGeometry.width() * 0.7;
+    const int screenMaxHeight = screenGeometry.height() * 0.7;
+    const int minWidth = 640;
+    const int minHeight = 360;
 
-        resize(dialogWidth, dialogHeight);
-        move((screenGeometry.width() - dialogWidth) / 2,
-             (screenGeometry.height() - dialogHeight) / 2);
-    } else {
-        m_imageLabel->setText("이미지를 불러올 수 없습니다.");
-    }
+    // 2. 맞춤 크기 계산 (실제 축소는 뷰가 피라미드 단계로 그림)
+    QSize scaledSize = imageSize.isEmpty() ? QSize(minWidth, minHeight) : imageSize;
+    scaledSize.scale(screenMaxWidth, screenMaxHeight, Qt::KeepAspectRatio);
 
-    m_timestampLabel->setText(QString("촬영 시간: %1").arg(timestamp));
-    m_logTextEdit->setPlainText(logText);
+    // 최소 크기 보장
+    scaledSize.setWidth(std::max(scaledSize.width(), minWidth));
+    scaledSize.setHeight(std::max(scaledSize.height(), minHeight));
+
+    // 3. 창 크기 동적으로 조정
+    const int headerHeight = 60; // 타이틀 + 버튼 여유
+    const int logAreaHeight = 180; // 로그 영역 여유
+    const int margin = 40;
+
+    int dialogWidth = scaledSize.width() + margin;
+    int dialogHeight = scaledSize.height() + headerHeight + logAreaHeight;
+
+    resize(dialogWidth, dialogHeight);
+    move((screenGeometry.width() - dialogWidth) / 2,
+         (screenGeometry.height() - dialogHeight) / 2);
 }
 
+void ImageViewerDialog::hideEvent(QHideEvent *event)
+{
+    // 원본 피라미드와 타일은 닫을 때 바로 해제 (4K 한 장에 수십 MB)
+    m_imageView->clear();
+    QDialog::hideEvent(event);
+}
 
 void ImageViewerDialog::keyPressEvent(QKeyEvent *event)
 {
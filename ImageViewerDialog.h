@@ -5,8 +5,9 @@
 #include <QLabel>
 #include <QTextEdit>
 #include <QPushButton>
-#include <QScrollArea>
-#include <QPixmap>
+#include <QImage>
+
+class TiledImageView;
 
 class ImageViewerDialog : public QDialog
 {
@@ -16,19 +17,24 @@ public:
     explicit ImageViewerDialog(QWidget *parent = nullptr);
     ~ImageViewerDialog();
 
-    void setImage(const QPixmap &pixmap, const QString &timestamp, const QString &logText);
+    void setImage(const QImage &image, const QString &timestamp, const QString &logText);
+    // 원본 디코드와 피라미드 생성은 작업 스레드에서 (창은 헤더 크기로 바로 뜸)
+    void setEncodedImage(const QByteArray &encodedData, const QString &timestamp, const QString &logText);
 
 protected:
     void keyPressEvent(QKeyEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
 
 private:
     void setupUI();
+    void resizeToImage(const QSize &imageSize);
+    void setDetails(const QString &timestamp, const QString &logText);
 
-    QLabel *m_imageLabel;
+    TiledImageView *m_imageView;
+    QLabel *m_zoomLabel;
     QLabel *m_timestampLabel;
     QTextEdit *m_logTextEdit;
     QPushButton *m_closeButton;
-    QScrollArea *m_scrollArea;
 };
 
 #endif // IMAGEVIEWERDIALOG_H
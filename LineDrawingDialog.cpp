@@ -1,5 +1,8 @@
 #include "LineDrawingDialog.h"
+#include "RtspStreamSource.h"
 #include "custommessagebox.h"
+#include "EnvConfig.h"
+#include <QVideoSink>
 #include <QApplication>
 #include <QMessageBox>
 #include <QDebug>
@@ -21,6 +24,8 @@ VideoGraphicsView::VideoGraphicsView(QWidget *parent)
     , m_currentCategory(LineCategory::ROAD_DEFINITION)
     , m_originalVideoSize(3840, 2160)  // 기본 원본 크기 설정
     , m_currentViewSize(960, 540)      // 현재 뷰 크기 설정
+    , m_bboxSyncEnabled(true)
+    , m_streamSource(nullptr)
 {
     // 씬 생성
     m_scene = new QGraphicsScene(this);
@@ -32,6 +37,12 @@ VideoGraphicsView::VideoGraphicsView(QWidget *parent)
     m_videoItem->setZValue(-1000); // 비디오를 가장 뒤로 보내기
     m_scene->addItem(m_videoItem);
 
+    // BBox 를 화면에 올라온 프레임의 캡처 시각에 맞춰 그림 (BBOX_SYNC=false 면 도착 즉시)
+    m_bboxSyncEnabled = EnvConfig::getBoolValue("BBOX_SYNC", true);
+    m_bboxBuffer.setSyncOffsetMs(EnvConfig::getIntValue("BBOX_SYNC_OFFSET_MS", 0));
+    m_bboxBuffer.setMaxAgeMs(EnvConfig::getIntValue("BBOX_MAX_AGE_MS", 500));
+    connect(m_videoItem->videoSink(), &QVideoSink::videoFrameChanged, this, &VideoGraphicsView::onVideoFrameChanged);
+
     // 뷰 설정
     setMinimumSize(960, 540);
     setMaximumSize(960, 540);
@@ -481,9 +492,34 @@ void VideoGraphicsView::clearHighlight()
 
 // BBox 관련 함수 구현
 void VideoGraphicsView::setBBoxes(const QList<BBox> &bboxes, qint64 timestamp)
+{
+    // 타임스탬프가 없거나 (0) 비디오 PTS 를 아직 모르면 예전처럼 바로 그림
+    if (m_bboxSyncEnabled && timestamp > 0 && m_bboxBuffer.isSynchronized()) {
+        m_bboxBuffer.push(bboxes, timestamp);
+        return;
+    }
+    drawBBoxes(bboxes, timestamp);
+}
+
+void VideoGraphicsView::onVideoFrameChanged(const QVideoFrame &frame)
+{
+    if (!m_bboxSyncEnabled || !frame.isValid()) {
+        return;
+    }
+
+    // 화면 도착 시각이 아니라 PLAY 기준 캡처 시각 (디코드/재생 버퍼링 시간 제외)
+    const qint64 captureMs = m_streamSource ? m_streamSource->captureTimeMs(frame.startTime()) : -1;
+    QList<BBox> bboxes;
+    qint64 timestamp = 0;
+    if (m_bboxBuffer.takeForFrame(captureMs, bboxes, timestamp)) {
+        drawBBoxes(bboxes, timestamp);
+    }
+}
+
+void VideoGraphicsView::drawBBoxes(const QList<BBox> &bboxes, qint64 timestamp)
 {
     // 기존 BBox 아이템들 제거
-    clearBBoxes();
+    removeBBoxItems();
 
     // 스케일 계산 (원본 해상도 → 뷰어 해상도)
     double scaleX = static_cast<double>(m_currentViewSize.width()) / m_originalVideoSize.width();
@@ -535,6 +571,15 @@ void VideoGraphicsView::setBBoxes(const QList<BBox> &bboxes, qint64 timestamp)
 }
 
 void VideoGraphicsView::clearBBoxes()
+{
+    // 아직 그리지 않은 프레임도 버림 (BBox 끄기)
+    m_bboxBuffer.clear();
+    removeBBoxItems();
+
+    qDebug() << "[VideoView] BBox 아이템들 제거 완료";
+}
+
+void VideoGraphicsView::removeBBoxItems()
 {
     // 기존 BBox 사각형 아이템들 제거
     for (QGraphicsRectItem* item : m_bboxRectItems) {
@@ -553,8 +598,6 @@ void VideoGraphicsView::clearBBoxes()
         }
     }
     m_bboxTextItems.clear();
-
-    qDebug() << "[VideoView] BBox 아이템들 제거 완료";
 }
 
 void VideoGraphicsView::mouseMoveEvent(QMouseEvent *event)
@@ -654,8 +697,7 @@ LineDrawingDialog::LineDrawingDialog(const QString &rtspUrl, QWidget *parent)
     , m_logTextEdit(nullptr)
     , m_logCountLabel(nullptr)
     , m_clearLogButton(nullptr)
-    , m_mediaPlayer(nullptr)
-    , m_audioOutput(nullptr)
+    , m_streamSource(nullptr)
     , m_rtspUrl(rtspUrl)
     , m_drawnLines()
     , m_isDrawingMode(false)
@@ -681,8 +723,7 @@ LineDrawingDialog::LineDrawingDialog(const QString &rtspUrl, QWidget *parent)
     // TCP 통신 설정 및 저장된 선 데이터 요청
     setupTcpConnection();
 
-    // 비디오 스트림 시작
-    QTimer::singleShot(500, this, &LineDrawingDialog::startVideoStream);
+    // 비디오 스트림은 다이얼로그가 보일 때 공유 소스에 연결 (showEvent)
 }
 
 LineDrawingDialog::LineDrawingDialog(const QString &rtspUrl, TcpCommunicator* tcpCommunicator, QWidget *parent)
@@ -700,8 +741,7 @@ LineDrawingDialog::LineDrawingDialog(const QString &rtspUrl, TcpCommunicator* tc
     , m_logTextEdit(nullptr)
     , m_logCountLabel(nullptr)
     , m_clearLogButton(nullptr)
-    , m_mediaPlayer(nullptr)
-    , m_audioOutput(nullptr)
+    , m_streamSource(nullptr)
     , m_rtspUrl(rtspUrl)
     , m_drawnLines()
     , m_isDrawingMode(false)
@@ -726,8 +766,7 @@ LineDrawingDialog::LineDrawingDialog(const QString &rtspUrl, TcpCommunicator* tc
     // TCP 통신 설정 및 저장된 선 데이터 요청
     setupTcpConnection();
 
-    // 비디오 스트림 시작
-    QTimer::singleShot(500, this, &LineDrawingDialog::startVideoStream);
+    // 비디오 스트림은 다이얼로그가 보일 때 공유 소스에 연결 (showEvent)
 }
 
 // TCP 통신기 설정 메서드
@@ -1015,12 +1054,6 @@ void LineDrawingDialog::onCoordinateClicked(int lineIndex, const QPoint &coordin
 LineDrawingDialog::~LineDrawingDialog()
 {
     stopVideoStream();
-    if (m_mediaPlayer) {
-        delete m_mediaPlayer;
-    }
-    if (m_audioOutput) {
-        delete m_audioOutput;
-    }
 }
 
 void LineDrawingDialog::setupUI()
@@ -1336,29 +1369,28 @@ void LineDrawingDialog::onStartDrawingClicked()
 
 void LineDrawingDialog::setupMediaPlayer()
 {
-    m_mediaPlayer = new QMediaPlayer(this);
-    m_audioOutput = new QAudioOutput(this);
-    m_mediaPlayer->setAudioOutput(m_audioOutput);
-
-    // QGraphicsVideoItem에 비디오 출력 설정
-    m_mediaPlayer->setVideoOutput(m_videoView->getVideoItem());
+    if (m_rtspUrl.isEmpty()) {
+        return;
+    }
 
-    // 볼륨 설정 (0으로 설정하여 소리 끄기)
-    m_audioOutput->setVolume(0.0);
+    // 라이브 탭이 이미 재생 중이면 두 번째 세션을 열지 않고 같은 디코드 결과를 받는다
+    m_streamSource = RtspStreamSource::forUrl(m_rtspUrl);
+    m_videoView->setStreamSource(m_streamSource);
+    QMediaPlayer *player = m_streamSource->player();
 
-    connect(m_mediaPlayer, &QMediaPlayer::playbackStateChanged, this, &LineDrawingDialog::onPlayerStateChanged);
-    connect(m_mediaPlayer, &QMediaPlayer::errorOccurred, this, &LineDrawingDialog::onPlayerError);
-    connect(m_mediaPlayer, &QMediaPlayer::mediaStatusChanged, this, &LineDrawingDialog::onMediaStatusChanged);
+    connect(player, &QMediaPlayer::playbackStateChanged, this, &LineDrawingDialog::onPlayerStateChanged);
+    connect(player, &QMediaPlayer::errorOccurred, this, &LineDrawingDialog::onPlayerError);
+    connect(player, &QMediaPlayer::mediaStatusChanged, this, &LineDrawingDialog::onMediaStatusChanged);
 
     qDebug() << "미디어 플레이어 설정 완료";
 }
 
 void LineDrawingDialog::startVideoStream()
 {
-    if (!m_rtspUrl.isEmpty()) {
+    if (m_streamSource) {
         qDebug() << "RTSP 스트림 시작:" << m_rtspUrl;
-        m_mediaPlayer->setSource(QUrl(m_rtspUrl));
-        m_mediaPlayer->play();
+        // QGraphicsVideoItem 의 싱크를 공유 소스에 연결 (이미 연결되어 있으면 무시)
+        m_streamSource->attach(m_videoView->getVideoItem()->videoSink());
         // m_statusLabel->setText("비디오 스트림 연결 중...");
     } else {
         // m_statusLabel->setText("RTSP URL이 설정되지 않았습니다.");
@@ -1368,14 +1400,28 @@ void LineDrawingDialog::startVideoStream()
 
 void LineDrawingDialog::stopVideoStream()
 {
-    if (m_mediaPlayer) {
-        m_mediaPlayer->stop();
+    if (m_streamSource && m_videoView) {
+        m_streamSource->detach(m_videoView->getVideoItem()->videoSink());
     }
     // if (m_frameTimer) {
     //     m_frameTimer->stop();
     // }
 }
 
+void LineDrawingDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    // 다이얼로그는 닫혀도 재사용되므로 다시 열 때 연결
+    startVideoStream();
+}
+
+void LineDrawingDialog::hideEvent(QHideEvent *event)
+{
+    // 닫혀 있는 동안은 프레임을 받지 않음 (마지막 화면이면 세션도 종료)
+    stopVideoStream();
+    QDialog::hideEvent(event);
+}
+
 void LineDrawingDialog::onStopDrawingClicked()
 {
     m_startDrawingButton->show();
@@ -1907,6 +1953,10 @@ void LineDrawingDialog::onBBoxesReceived(const QList<BBox> &bboxes, qint64 times
     
     // VideoGraphicsView에 Bounding Box 전달
     if (m_videoView) {
+        // BBox 타임스탬프(서버 시각)를 비디오 프레임과 같은 로컬 단조 시각으로 옮김
+        if (m_tcpCommunicator) {
+            m_videoView->bboxBuffer().setClockOffsetMs(m_tcpCommunicator->serverToLocalOffsetMs());
+        }
         m_videoView->setBBoxes(bboxes, timestamp);
         
         // 로그 메시지 추가
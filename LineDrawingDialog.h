@@ -9,7 +9,6 @@
 #include <QLabel>
 #include <QVideoWidget>
 #include <QMediaPlayer>
-#include <QAudioOutput>
 #include <QSlider>
 #include <QTimer>
 #include <QMouseEvent>
@@ -24,6 +23,7 @@
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QGraphicsVideoItem>
+#include <QVideoFrame>
 #include <QGraphicsLineItem>
 #include <QGraphicsEllipseItem>
 #include <QGraphicsRectItem>
@@ -32,6 +32,7 @@
 #include <QButtonGroup>
 #include <QFrame>
 #include "TcpCommunicator.h"
+#include "BBoxJitterBuffer.h"
 #include <QInputDialog>
 
 // 선 카테고리 열거형
@@ -56,6 +57,8 @@ struct CoordinateMatrixMapping {
     QString displayName;    // 표시용 이름
 };
 
+class RtspStreamSource;
+
 // QGraphicsView 기반 비디오 뷰어
 class VideoGraphicsView : public QGraphicsView
 {
@@ -83,9 +86,13 @@ public:
     void drawImmediateTestLines();
 
     // BBox 관련 함수
+    // 동기화가 켜져 있으면 지터 버퍼에 넣고, 해당 캡처 시각의 비디오 프레임이 화면에 올라올 때 그린다
     void setBBoxes(const QList<BBox> &bboxes, qint64 timestamp);
     void clearBBoxes();
     void setOriginalVideoSize(const QSize &size) { m_originalVideoSize = size; }
+    BBoxJitterBuffer &bboxBuffer() { return m_bboxBuffer; }
+    // 프레임 캡처 시각을 추정해 줄 스트림 (BBox 동기화용)
+    void setStreamSource(RtspStreamSource *source) { m_streamSource = source; }
 
 signals:
     void lineDrawn(const QPoint &start, const QPoint &end, LineCategory category);
@@ -97,6 +104,9 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event) override;
 
 private:
+    void onVideoFrameChanged(const QVideoFrame &frame);
+    void drawBBoxes(const QList<BBox> &bboxes, qint64 timestamp);
+    void removeBBoxItems();
     void redrawAllLines();
     QGraphicsLineItem* findClickedRoadLine(const QPointF &clickPos);
     void highlightRoadLine(int lineIndex);
@@ -120,6 +130,9 @@ private:
     QList<QGraphicsTextItem*> m_bboxTextItems;     // BBox 텍스트 아이템들
     QSize m_originalVideoSize;                      // 원본 비디오 크기
     QSize m_currentViewSize;                        // 현재 뷰 크기
+    BBoxJitterBuffer m_bboxBuffer;                  // 캡처 시각으로 비디오 프레임과 맞춤
+    bool m_bboxSyncEnabled;
+    RtspStreamSource *m_streamSource;
 };
 
 class LineDrawingDialog : public QDialog
@@ -167,6 +180,8 @@ private slots:
 
 protected:
     void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
 
 private:
     // 좌표별 Matrix 매핑 저장
@@ -194,9 +209,8 @@ private:
     QLabel *m_logCountLabel;
     QPushButton *m_clearLogButton;
 
-    // 미디어 관련
-    QMediaPlayer *m_mediaPlayer;
-    QAudioOutput *m_audioOutput;
+    // 미디어 관련 (라이브 탭과 같은 RTSP 세션/디코더를 공유)
+    RtspStreamSource *m_streamSource;
 
     // 상태 관리
     QString m_rtspUrl;
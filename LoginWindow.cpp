@@ -31,7 +31,6 @@ LoginWindow::LoginWindow(QWidget *parent)
     , m_closeSignUpButton(nullptr)
     , m_closeOtpSignUpButton(nullptr)
     , m_connectionStatusLabel(nullptr)
-    , m_connectionTimer(nullptr)
 {
     qDebug() << "[LoginWindow] 생성자 시작";
 
@@ -72,9 +71,6 @@ LoginWindow::LoginWindow(QWidget *parent)
     setModal(true);
     setWindowTitle("CCTV 모니터링 시스템 - 로그인");
 
-    // 연결 상태 확인 타이머 설정
-    setupConnectionTimer();
-
     qDebug() << "[LoginWindow] 생성자 완료";
 }
 
@@ -82,11 +78,6 @@ LoginWindow::~LoginWindow()
 {
     qDebug() << "[LoginWindow] 소멸자 호출";
 
-
-    if (m_connectionTimer) {
-        m_connectionTimer->stop();
-    }
-
     delete ui;
 
     qDebug() << "[LoginWindow] 소멸자 완료";
@@ -122,28 +113,42 @@ void LoginWindow::setTcpCommunicator(TcpCommunicator* communicator)
 {
     // 기존 연결 해제
     if (m_tcpCommunicator && m_tcpCommunicator != communicator) {
+        disconnect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                  this, &LoginWindow::onTcpConnectionStateChanged);
         disconnect(m_tcpCommunicator, &TcpCommunicator::connected,
                   this, &LoginWindow::onTcpConnected);
         disconnect(m_tcpCommunicator, &TcpCommunicator::disconnected,
                   this, &LoginWindow::onTcpDisconnected);
         disconnect(m_tcpCommunicator, &TcpCommunicator::errorOccurred,
                   this, &LoginWindow::onTcpError);
-        disconnect(m_tcpCommunicator, &TcpCommunicator::messageReceived,
-                  this, &LoginWindow::onTcpMessageReceived);
+        m_tcpCommunicator->unregisterHandlers(this);
+
+        // 이 창이 만든 통신기라면 연결을 닫아 소켓이 두 개 열려 있지 않도록 한다
+        if (m_tcpCommunicator->parent() == this) {
+            m_tcpCommunicator->setReconnectEnabled(false);
+            m_tcpCommunicator->disconnectFromServer();
+        }
     }
 
     m_tcpCommunicator = communicator;
 
     // 새로운 통신기에 시그널 연결
     if (m_tcpCommunicator) {
+        connect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                this, &LoginWindow::onTcpConnectionStateChanged, Qt::UniqueConnection);
         connect(m_tcpCommunicator, &TcpCommunicator::connected,
                 this, &LoginWindow::onTcpConnected);
         connect(m_tcpCommunicator, &TcpCommunicator::disconnected,
                 this, &LoginWindow::onTcpDisconnected);
         connect(m_tcpCommunicator, &TcpCommunicator::errorOccurred,
                 this, &LoginWindow::onTcpError);
-        connect(m_tcpCommunicator, &TcpCommunicator::messageReceived,
-                this, &LoginWindow::onTcpMessageReceived);
+        registerResponseHandlers();
+
+        // 아직 연결되지 않은 통신기라면 바로 연결을 시작하고, 현재 상태를 라벨에 반영
+        if (m_tcpCommunicator->connectionState() == TcpCommunicator::ConnectionState::Disconnected) {
+            m_tcpCommunicator->connectToServer(m_tcpHost, m_tcpPort);
+        }
+        onTcpConnectionStateChanged(m_tcpCommunicator->connectionState());
     }
 }
 
@@ -163,47 +168,38 @@ void LoginWindow::setupConnectionStatusLabel()
     m_connectionStatusLabel->show();
 }
 
-void LoginWindow::setupConnectionTimer()
+void LoginWindow::updateConnectionStatusLabel(const QString &text, const QString &color)
 {
-    // 연결 상태 확인 타이머 (5초마다 확인)
-    m_connectionTimer = new QTimer(this);
-    m_connectionTimer->setInterval(5000); // 5초
-    connect(m_connectionTimer, &QTimer::timeout, this, &LoginWindow::checkConnectionStatus);
-    m_connectionTimer->start();
+    m_connectionStatusLabel->setText(text);
+    m_connectionStatusLabel->setStyleSheet(QString(
+        "QLabel {"
+        "    color: %1;"
+        "    font-size: 11px;"
+        "    background-color: transparent;"
+        "}").arg(color));
 }
 
-void LoginWindow::checkConnectionStatus()
+void LoginWindow::onTcpConnectionStateChanged(TcpCommunicator::ConnectionState state)
 {
-    qDebug() << "[LoginWindow] 연결 상태 확인";
+    qDebug() << "[LoginWindow] TCP 연결 상태:" << TcpCommunicator::connectionStateToString(state);
 
-    if (m_tcpCommunicator) {
-        bool isConnected = m_tcpCommunicator->isConnectedToServer();
-        qDebug() << "[LoginWindow] TCP 연결 상태:" << isConnected;
-
-        if (isConnected) {
-            m_connectionStatusLabel->setText("서버 연결됨");
-            m_connectionStatusLabel->setStyleSheet(
-                "QLabel {"
-                "    color: #28a745;"
-                "    font-size: 11px;"
-                "    background-color: transparent;"
-                "}"
-                );
-        } else {
-            m_connectionStatusLabel->setText("서버 연결 끊어짐 - 재연결 시도 중...");
-            m_connectionStatusLabel->setStyleSheet(
-                "QLabel {"
-                "    color: #dc3545;"
-                "    font-size: 11px;"
-                "    background-color: transparent;"
-                "}"
-                );
-
-            // 재연결 시도
-            m_tcpCommunicator->connectToServer(m_tcpHost, m_tcpPort);
-        }
-    } else {
-        qDebug() << "[LoginWindow] TcpCommunicator가 초기화되지 않음";
+    switch (state) {
+    case TcpCommunicator::ConnectionState::Ready:
+        updateConnectionStatusLabel("서버 연결됨", "#28a745");
+        break;
+    case TcpCommunicator::ConnectionState::Resolving:
+        updateConnectionStatusLabel("서버 주소 확인 중...", "#ffc107");
+        break;
+    case TcpCommunicator::ConnectionState::Connecting:
+        updateConnectionStatusLabel("서버 연결 시도 중...", "#ffc107");
+        break;
+    case TcpCommunicator::ConnectionState::Handshaking:
+        updateConnectionStatusLabel("보안 연결 설정 중...", "#ffc107");
+        break;
+    case TcpCommunicator::ConnectionState::Disconnected:
+        // 재연결은 TcpCommunicator 의 ReconnectScheduler 가 맡음 - 여기서는 상태만 표시
+        updateConnectionStatusLabel("서버 연결 끊어짐", "#dc3545");
+        break;
     }
 }
 
@@ -290,28 +286,22 @@ void LoginWindow::setupTcpCommunication()
     m_tcpCommunicator = new TcpCommunicator(this);
 
     // TCP 시그널 연결
+    connect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+            this, &LoginWindow::onTcpConnectionStateChanged);
     connect(m_tcpCommunicator, &TcpCommunicator::connected,
             this, &LoginWindow::onTcpConnected);
     connect(m_tcpCommunicator, &TcpCommunicator::disconnected,
             this, &LoginWindow::onTcpDisconnected);
     connect(m_tcpCommunicator, &TcpCommunicator::errorOccurred,
             this, &LoginWindow::onTcpError);
-    connect(m_tcpCommunicator, &TcpCommunicator::messageReceived,
-            this, &LoginWindow::onTcpMessageReceived);
+    registerResponseHandlers();
 
-    // 서버 연결 시도
+    // 서버 연결 시도 (비동기, 진행 상황은 connectionStateChanged 로 표시)
     qDebug() << "[LoginWindow] 서버 연결 시도:" << m_tcpHost << ":" << m_tcpPort;
     m_tcpCommunicator->connectToServer(m_tcpHost, m_tcpPort);
 
     // 연결 상태 업데이트
-    m_connectionStatusLabel->setText("서버 연결 시도 중...");
-    m_connectionStatusLabel->setStyleSheet(
-        "QLabel {"
-        "    color: #ffc107;"
-        "    font-size: 11px;"
-        "    background-color: transparent;"
-        "}"
-        );
+    updateConnectionStatusLabel("서버 연결 시도 중...", "#ffc107");
 
     qDebug() << "[LoginWindow] TCP 통신 설정 완료";
 }
@@ -412,8 +402,10 @@ void LoginWindow::handleLogin()
         msgBox.setFixedSize(300,150);
         msgBox.exec();
 
-        // 재연결 시도
-        m_tcpCommunicator->connectToServer(m_tcpHost, m_tcpPort);
+        // 백오프를 기다리지 않고 바로 재시도 (연결 시도 중이면 무시됨)
+        if (m_tcpCommunicator) {
+            m_tcpCommunicator->reconnectNow();
+        }
         return;
     }
 
@@ -477,8 +469,10 @@ void LoginWindow::handleSubmitSignUp()
         msgBox.setFixedSize(300,150);
         msgBox.exec();
 
-        // 재연결 시도
-        m_tcpCommunicator->connectToServer(m_tcpHost, m_tcpPort);
+        // 백오프를 기다리지 않고 바로 재시도 (연결 시도 중이면 무시됨)
+        if (m_tcpCommunicator) {
+            m_tcpCommunicator->reconnectNow();
+        }
         return;
     }
 
@@ -681,32 +675,12 @@ void LoginWindow::clearLoginFields()
 void LoginWindow::onTcpConnected()
 {
     qDebug() << "[LoginWindow] TCP 연결 성공";
-
-    // 연결 상태 업데이트
-    m_connectionStatusLabel->setText("서버 연결됨");
-    m_connectionStatusLabel->setStyleSheet(
-        "QLabel {"
-        "    color: #28a745;"
-        "    font-size: 11px;"
-        "    background-color: transparent;"
-        "}"
-        );
 }
 
 void LoginWindow::onTcpDisconnected()
 {
     qDebug() << "[LoginWindow] TCP 연결 해제";
 
-    // 연결 상태 업데이트
-    m_connectionStatusLabel->setText("서버 연결 끊어짐");
-    m_connectionStatusLabel->setStyleSheet(
-        "QLabel {"
-        "    color: #dc3545;"
-        "    font-size: 11px;"
-        "    background-color: transparent;"
-        "}"
-        );
-
     // 사용자에게 알림 (한 번만)
     static bool disconnectNotified = false;
     if (!disconnectNotified && this->isVisible()) {
@@ -727,14 +701,7 @@ void LoginWindow::onTcpError(const QString &error)
     qDebug() << "[LoginWindow] TCP 오류:" << error;
 
     // 연결 상태 업데이트
-    m_connectionStatusLabel->setText("연결 오류 - 재시도 중...");
-    m_connectionStatusLabel->setStyleSheet(
-        "QLabel {"
-        "    color: #dc3545;"
-        "    font-size: 11px;"
-        "    background-color: transparent;"
-        "}"
-        );
+    updateConnectionStatusLabel("연결 오류 - 재시도 중...", "#dc3545");
 
     // 버튼 상태 복원
     resetLoginButton();
@@ -744,45 +711,23 @@ void LoginWindow::onTcpError(const QString &error)
     qDebug() << "[LoginWindow] 상세 오류 정보:" << error;
 }
 
-void LoginWindow::onTcpMessageReceived(const QString &message)
+void LoginWindow::registerResponseHandlers()
 {
-    qDebug() << "[LoginWindow] TCP 메시지 수신:" << message;
-
-    // JSON 파싱
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
-
-    if (error.error != QJsonParseError::NoError) {
-        qDebug() << "[LoginWindow] JSON 파싱 오류:" << error.errorString();
-        qDebug() << "[LoginWindow] 원본 메시지:" << message;
-        return;
-    }
+    // 응답 id 별 핸들러 등록 - 통신기가 파싱한 JSON 객체를 그대로 받는다
+    m_tcpCommunicator->unregisterHandlers(this);
 
-    QJsonObject jsonObj = doc.object();
-    int requestId = jsonObj["request_id"].toInt();
-
-    qDebug() << "[LoginWindow] 파싱된 request_id:" << requestId;
-
-    // 응답 처리
-    switch (requestId) {
-    case 19: // 로그인 응답
+    m_tcpCommunicator->registerHandler(19, this, [this](const QJsonObject &response) {
         qDebug() << "[LoginWindow] 로그인 응답 처리";
-        handleLoginResponse(jsonObj);
-        break;
-    case 20: // 회원가입 응답
+        handleLoginResponse(response);
+    });
+    m_tcpCommunicator->registerHandler(20, this, [this](const QJsonObject &response) {
         qDebug() << "[LoginWindow] 회원가입 응답 처리";
-        handleSignUpResponse(jsonObj);
-        break;
-    case 23:
+        handleSignUpResponse(response);
+    });
+    m_tcpCommunicator->registerHandler(23, this, [this](const QJsonObject &response) {
         qDebug() << "[LoginWindow] 2차 로그인 응답 처리";
-        handleOtpLoginResponse(jsonObj);
-        break;
-
-    default:
-        qDebug() << "[LoginWindow] 알 수 없는 request_id:" << requestId;
-        qDebug() << "[LoginWindow] 전체 JSON:" << QJsonDocument(jsonObj).toJson(QJsonDocument::Compact);
-        break;
-    }
+        handleOtpLoginResponse(response);
+    });
 }
 
 void LoginWindow::handleLoginResponse(const QJsonObject &response)
@@ -13,7 +13,7 @@
 #include <QMessageBox>
 #include <QDebug>
 
-class TcpCommunicator;
+#include "TcpCommunicator.h"
 
 QT_BEGIN_NAMESPACE
 class Ui_LoginWindow;
@@ -51,14 +51,13 @@ private slots:
     void handleCloseOtpSignUp();
     void onPasswordChanged();
 
-    // 연결 상태 확인
-    void checkConnectionStatus();
+    // 연결 상태 (폴링 없이 상태 변경 시그널로 갱신)
+    void onTcpConnectionStateChanged(TcpCommunicator::ConnectionState state);
 
     // TCP 통신 관련 슬롯
     void onTcpConnected();
     void onTcpDisconnected();
     void onTcpError(const QString &error);
-    void onTcpMessageReceived(const QString &message);
 
 private:
     Ui_LoginWindow *ui;
@@ -71,7 +70,6 @@ private:
     QPushButton *m_closeSignUpButton;
     QPushButton *m_closeOtpSignUpButton;
     QLabel *m_connectionStatusLabel;
-    QTimer *m_connectionTimer;
 
     // 사용자 데이터
     QString m_currentUserId;
@@ -86,8 +84,8 @@ private:
     void setupPasswordErrorLabel();
     void setupCloseButtons();
     void setupConnectionStatusLabel();
-    void setupConnectionTimer();
     void setupTcpCommunication();
+    void updateConnectionStatusLabel(const QString &text, const QString &color);
     void connectSignals();
 
     // TCP 통신 메서드
@@ -98,6 +96,7 @@ private:
     void generateOtpQrCode(const QString &id, const QString &password);
 
     // 응답 처리 메서드
+    void registerResponseHandlers();
     void handleLoginResponse(const QJsonObject &response);
     void handleSignUpResponse(const QJsonObject &response);
     void handleOtpLoginResponse(const QJsonObject &response);
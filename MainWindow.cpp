@@ -3,6 +3,9 @@
 #include "NetworkConfigDialog.h"
 #include "EnvConfig.h"
 #include "custommessagebox.h"
+#include "ReconnectScheduler.h"
+#include "CaptureTileDelegate.h"
+#include "DecodeBudgetScheduler.h"
 #include <QApplication>
 #include <QStackedLayout>
 #include <QMessageBox>
@@ -17,29 +20,10 @@
 #include <QComboBox>
 #include <QCalendarWidget>
 #include <QDialog>
-
-// ClickableImageLabel 구현
-ClickableImageLabel::ClickableImageLabel(QWidget *parent)
-    : QLabel(parent)
-{
-    setCursor(Qt::PointingHandCursor);
-    setStyleSheet("border: 2px solid #ddd; border-radius: 8px; padding: 5px; background-color: white;");
-}
-
-void ClickableImageLabel::setImageData(const QString &imagePath, const QString &timestamp, const QString &logText)
-{
-    m_imagePath = imagePath;
-    m_timestamp = timestamp;
-    m_logText = logText;
-}
-
-void ClickableImageLabel::mousePressEvent(QMouseEvent *event)
-{
-    if (event->button() == Qt::LeftButton) {
-        emit clicked(m_imagePath, m_timestamp, m_logText);
-    }
-    QLabel::mousePressEvent(event);
-}
+#include <QScrollBar>
+#include <QStandardItemModel>
+#include <QTextCharFormat>
+#include <algorithm>
 
 // MainWindow 구현
 MainWindow::MainWindow(QWidget *parent)
@@ -49,15 +33,24 @@ MainWindow::MainWindow(QWidget *parent)
     , m_closeButton(nullptr)
     , m_liveVideoTab(nullptr)
     , m_videoStreamWidget(nullptr)
+    , m_cameraGrid(nullptr)
     , m_streamingButton(nullptr)
     , m_capturedImageTab(nullptr)
-    , m_imageScrollArea(nullptr)
-    , m_imageGridWidget(nullptr)
-    , m_imageGridLayout(nullptr)
+    , m_galleryView(nullptr)
+    , m_galleryModel(nullptr)
+    , m_galleryMessageLabel(nullptr)
+    , m_galleryStreaming(false)
+    , m_galleryHour(-1)
+    , m_galleryHasMore(false)
+    , m_galleryPageSize(60)
+    , m_galleryMetadataFirst(true)
+    , m_thumbnailCache(nullptr)
+    , m_hourPrefetcher(nullptr)
     , m_dateButton(nullptr)
     , m_calendarWidget(nullptr)
     , m_calendarDialog(nullptr)
     , m_hourComboBox(nullptr)
+    , m_hourHeatStrip(nullptr)
     , m_dateEdit(nullptr)
     , m_hourSpinBox(nullptr)
     , m_requestButton(nullptr)
@@ -70,7 +63,6 @@ MainWindow::MainWindow(QWidget *parent)
     , m_tcpCommunicator(nullptr)
     , m_networkManager(nullptr)
     , m_updateTimer(nullptr)
-    , m_requestTimeoutTimer(nullptr)
     , m_imageViewerDialog(nullptr)
     , m_networkDialog(nullptr)
     , m_lineDrawingDialog(nullptr)
@@ -88,6 +80,22 @@ MainWindow::MainWindow(QWidget *parent)
     // 선택된 날짜 초기화
     m_selectedDate = QDate::currentDate();
 
+    // 갤러리 썸네일은 타일 크기로 바로 디코드해 메모리 한도 안에서 보관 (THUMBNAIL_CACHE_MB)
+    m_thumbnailCache = new ThumbnailCache(QSize(300, 200),
+                                          static_cast<qint64>(EnvConfig::getIntValue("THUMBNAIL_CACHE_MB", 64)) * 1024 * 1024,
+                                          this);
+    m_galleryModel = new CaptureGalleryModel(m_thumbnailCache, this);
+    // 첫 화면은 한 페이지만 받아서 그림 (GALLERY_PAGE_SIZE, 0 이면 시간대 전체를 한 번에)
+    m_galleryPageSize = EnvConfig::getIntValue("GALLERY_PAGE_SIZE", 60);
+    // 목록은 메타데이터와 서버 썸네일만 받고 원본은 뷰어에서 열 때 받음 (GALLERY_METADATA_FIRST=false 면 원본 목록)
+    m_galleryMetadataFirst = EnvConfig::getBoolValue("GALLERY_METADATA_FIRST", true);
+    // 보고 있는 시간의 앞뒤 시간 첫 페이지를 유휴 시간에 미리 받아 둠 (HOUR_PREFETCH_MB, 0 이면 끔)
+    const int prefetchMb = EnvConfig::getIntValue("HOUR_PREFETCH_MB", 16);
+    if (prefetchMb > 0) {
+        m_hourPrefetcher = new HourPrefetcher(m_thumbnailCache, this);
+        m_hourPrefetcher->setBudget(static_cast<qint64>(prefetchMb) * 1024 * 1024);
+    }
+
     // UI 설정
     setupUI();
 
@@ -117,8 +125,8 @@ MainWindow::~MainWindow()
     if (m_updateTimer) {
         m_updateTimer->stop();
     }
-    if (m_requestTimeoutTimer) {
-        m_requestTimeoutTimer->stop();
+    if (m_imageRequest) {
+        m_imageRequest->cancel();
     }
     if (m_calendarDialog) {
         delete m_calendarDialog;
@@ -130,6 +138,12 @@ void MainWindow::setTcpCommunicator(TcpCommunicator* communicator)
 {
     // 기존 연결 해제
     if (m_tcpCommunicator && m_tcpCommunicator != communicator) {
+        disconnect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                   this, &MainWindow::onTcpConnectionStateChanged);
+        if (m_networkDialog) {
+            disconnect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                       m_networkDialog, &NetworkConfigDialog::onConnectionStateChanged);
+        }
         disconnect(m_tcpCommunicator, &TcpCommunicator::connected,
                    this, &MainWindow::onTcpConnected);
         disconnect(m_tcpCommunicator, &TcpCommunicator::disconnected,
@@ -138,8 +152,6 @@ void MainWindow::setTcpCommunicator(TcpCommunicator* communicator)
                    this, &MainWindow::onTcpError);
         disconnect(m_tcpCommunicator, &TcpCommunicator::messageReceived,
                    this, &MainWindow::onTcpDataReceived);
-        disconnect(m_tcpCommunicator, &TcpCommunicator::imagesReceived,
-                   this, &MainWindow::onImagesReceived);
         disconnect(m_tcpCommunicator, &TcpCommunicator::coordinatesConfirmed,
                    this, &MainWindow::onCoordinatesConfirmed);
         disconnect(m_tcpCommunicator, &TcpCommunicator::statusUpdated,
@@ -152,6 +164,12 @@ void MainWindow::setTcpCommunicator(TcpCommunicator* communicator)
 
     // 새로운 통신기에 시그널 연결
     if (m_tcpCommunicator) {
+        connect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                this, &MainWindow::onTcpConnectionStateChanged, Qt::UniqueConnection);
+        if (m_networkDialog) {
+            connect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                    m_networkDialog, &NetworkConfigDialog::onConnectionStateChanged, Qt::UniqueConnection);
+        }
         connect(m_tcpCommunicator, &TcpCommunicator::connected,
                 this, &MainWindow::onTcpConnected);
         connect(m_tcpCommunicator, &TcpCommunicator::disconnected,
@@ -160,8 +178,6 @@ void MainWindow::setTcpCommunicator(TcpCommunicator* communicator)
                 this, &MainWindow::onTcpError);
         connect(m_tcpCommunicator, &TcpCommunicator::messageReceived,
                 this, &MainWindow::onTcpDataReceived);
-        connect(m_tcpCommunicator, &TcpCommunicator::imagesReceived,
-                this, &MainWindow::onImagesReceived);
         connect(m_tcpCommunicator, &TcpCommunicator::coordinatesConfirmed,
                 this, &MainWindow::onCoordinatesConfirmed);
         connect(m_tcpCommunicator, &TcpCommunicator::statusUpdated,
@@ -179,6 +195,14 @@ void MainWindow::setTcpCommunicator(TcpCommunicator* communicator)
                         msgBox.exec();
                     }
                 });
+
+        // 현재 연결 단계를 UI에 바로 반영
+        onTcpConnectionStateChanged(m_tcpCommunicator->connectionState());
+        requestHourCounts();
+    }
+
+    if (m_hourPrefetcher) {
+        m_hourPrefetcher->setTcpCommunicator(m_tcpCommunicator);
     }
 }
 
@@ -290,6 +314,7 @@ void MainWindow::setupLiveVideoTab()
 
     m_videoStreamWidget = new VideoStreamWidget();
     m_videoStreamWidget->setMinimumHeight(400);
+    m_videoStreamWidget->reconnectScheduler()->setNeverGiveUp(EnvConfig::getBoolValue("RECONNECT_NEVER_GIVE_UP", false));
 
     // 재생 버튼 (아이콘 이미지 사용)
     QPushButton *playOverlayButton = new QPushButton();
@@ -310,9 +335,33 @@ void MainWindow::setupLiveVideoTab()
     overlayLayout->addStretch();
     overlayLayout->setContentsMargins(0, 0, 0, 0);
 
+    // 카메라가 여러 대면 N 카메라 그리드 (RTSP_URLS="메인|서브,메인|서브,...", 서브는 생략 가능)
+    const QList<CameraSource> cameras = CameraGridWidget::parseCameraList(EnvConfig::getValue("RTSP_URLS", ""));
+    if (cameras.size() > 1) {
+        m_cameraGrid = new CameraGridWidget();
+        m_cameraGrid->setMinimumHeight(400);
+        // 원본 전체 fps 칸 수 / 초당 픽셀 예산 / 예산 밖 칸(서브 스트림 없음)의 한 장 갱신 주기
+        m_cameraGrid->scheduler()->setMaxFullRateTiles(EnvConfig::getIntValue("LIVE_FULL_RATE_TILES", 4));
+        m_cameraGrid->scheduler()->setPixelBudget(
+            static_cast<qint64>(EnvConfig::getIntValue("LIVE_DECODE_BUDGET_MPIX", 250)) * 1000 * 1000);
+        m_cameraGrid->scheduler()->setSnapshotIntervalMs(EnvConfig::getIntValue("LIVE_SNAPSHOT_INTERVAL_MS", 5000));
+        m_cameraGrid->setCameras(cameras);
+        m_cameraGrid->setGridSize(EnvConfig::getIntValue("LIVE_GRID", cameras.size() > 4 ? 3 : 2));
+        stackedLayout->addWidget(m_cameraGrid);
+
+        connect(m_cameraGrid, &CameraGridWidget::stopRequested, this, [=]() {
+            m_cameraGrid->stop();
+            stackedLayout->setCurrentWidget(overlayWidget);
+        });
+        connect(m_cameraGrid, &CameraGridWidget::drawButtonClicked, this, &MainWindow::onDrawButtonClicked);
+    }
+
     // ▶ 버튼 클릭 시: 영상 시작 + 영상 위젯을 전면에
     connect(playOverlayButton, &QPushButton::clicked, this, [=]() {
-        if (!m_rtspUrl.isEmpty()) {
+        if (m_cameraGrid) {
+            m_cameraGrid->start();
+            stackedLayout->setCurrentWidget(m_cameraGrid);
+        } else if (!m_rtspUrl.isEmpty()) {
             m_videoStreamWidget->startStream(m_rtspUrl);
             stackedLayout->setCurrentWidget(m_videoStreamWidget);
         } else {
@@ -335,6 +384,9 @@ void MainWindow::setupLiveVideoTab()
 
     // 클릭하면 재생 + 버튼 숨김
     connect(playOverlayButton, &QPushButton::clicked, this, [=]() {
+        if (m_cameraGrid) {
+            return;     // 그리드는 위 핸들러에서 시작
+        }
         if (!m_rtspUrl.isEmpty()) {
             m_videoStreamWidget->startStream(m_rtspUrl);
             stackedLayout->setCurrentWidget(m_videoStreamWidget);  // 영상 보여주기
@@ -359,7 +411,7 @@ void MainWindow::setupLiveVideoTab()
 
 void MainWindow::onDrawButtonClicked()
 {
-    if (!m_videoStreamWidget->isStreaming()) {
+    if (!m_videoStreamWidget->isStreaming() && !(m_cameraGrid && m_cameraGrid->isStreaming())) {
         CustomMessageBox msgBox(nullptr, "안내", "먼저 스트리밍을 시작해주세요.");
         msgBox.setFixedSize(300,150);
         msgBox.exec();
@@ -456,7 +508,7 @@ void MainWindow::setupCapturedImageTab()
         // 새로운 날짜(newDate)를 사용해 원하는 작업을 수행
         qDebug() << "날짜가 변경되었습니다: " << newDate.toString("yyyy-MM-dd");
         m_selectedDate = newDate;
-        // 다른 UI 업데이트나 로직을 여기에 추가할 수 있습니다.
+        requestHourCounts();
     });
 
     // 달력 다이얼로그 설정
@@ -514,6 +566,8 @@ void MainWindow::setupCapturedImageTab()
     m_calendarWidget->setSelectedDate(m_selectedDate);
     m_calendarWidget->setStyleSheet("background-color:#292D41;");
     connect(m_calendarWidget, &QCalendarWidget::clicked, this, &MainWindow::onCalendarDateSelected);
+    // 달력 페이지를 넘길 때마다 그 달의 일별 건수로 날짜 칸을 칠한다
+    connect(m_calendarWidget, &QCalendarWidget::currentPageChanged, this, &MainWindow::requestMonthCounts);
     calendarLayout->addWidget(m_calendarWidget);
 
     // 시간 라벨
@@ -571,24 +625,43 @@ void MainWindow::setupCapturedImageTab()
     topLayout->addStretch(); // 오른쪽 여백 확보
 
     mainLayout->addWidget(topBar);
-    // 이미지 영역
-    m_imageScrollArea = new QScrollArea();
-    m_imageScrollArea->setWidgetResizable(true);
-    m_imageScrollArea->setStyleSheet("QScrollArea { background-color: #474B5C; border: none;}");
-
-    m_imageGridWidget = new QWidget();
-    m_imageGridWidget->setStyleSheet("background-color: #474B5C; border: none;");
-    m_imageGridLayout = new QGridLayout(m_imageGridWidget);
-    m_imageGridLayout->setSpacing(15);
-    m_imageGridLayout->setContentsMargins(15, 15, 15, 15);
-
-    QLabel *emptyLabel = new QLabel("이미지 요청 버튼을 눌러 해당 시간대의 이미지를 불러오세요.");
-    emptyLabel->setAlignment(Qt::AlignCenter);
-    emptyLabel->setStyleSheet("color: #999; font-size: 16px; padding: 50px;");
-    m_imageGridLayout->addWidget(emptyLabel, 0, 0, 1, 2);
 
-    m_imageScrollArea->setWidget(m_imageGridWidget);
-    mainLayout->addWidget(m_imageScrollArea);
+    // 시간별 캡처 건수 띠 - 빈 시간대는 받지 않도록 미리 보여준다
+    m_hourHeatStrip = new CaptureHeatStrip();
+    m_hourHeatStrip->setCurrentHour(m_hourComboBox->currentData().toInt());
+    connect(m_hourHeatStrip, &CaptureHeatStrip::hourClicked, this, [this](int hour) {
+        m_hourComboBox->setCurrentIndex(m_hourComboBox->findData(hour));
+    });
+    mainLayout->addWidget(m_hourHeatStrip);
+
+    // 이미지 영역 - 캡처 수와 관계없이 보이는 칸만 그리는 리스트 뷰 (너비에 맞춰 카드 줄바꿈)
+    m_galleryView = new QListView();
+    m_galleryView->setModel(m_galleryModel);
+    m_galleryView->setItemDelegate(new CaptureTileDelegate(m_galleryView));
+    m_galleryView->setViewMode(QListView::IconMode);
+    m_galleryView->setFlow(QListView::LeftToRight);
+    m_galleryView->setWrapping(true);
+    m_galleryView->setResizeMode(QListView::Adjust);
+    m_galleryView->setMovement(QListView::Static);
+    m_galleryView->setUniformItemSizes(true);
+    m_galleryView->setSpacing(15);
+    m_galleryView->setSelectionMode(QAbstractItemView::NoSelection);
+    m_galleryView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_galleryView->verticalScrollBar()->setSingleStep(24);
+    m_galleryView->setMouseTracking(true);
+    m_galleryView->viewport()->setCursor(Qt::PointingHandCursor);
+    m_galleryView->setStyleSheet("QListView { background-color: #474B5C; border: none; }");
+    connect(m_galleryView, &QListView::clicked, this, &MainWindow::onGalleryItemClicked);
+    connect(m_galleryView->verticalScrollBar(), &QScrollBar::valueChanged, this, &MainWindow::onGalleryScrolled);
+    connect(m_galleryView->verticalScrollBar(), &QScrollBar::rangeChanged, this, &MainWindow::onGalleryScrolled);
+
+    m_galleryMessageLabel = new QLabel();
+    m_galleryMessageLabel->setAlignment(Qt::AlignCenter);
+    m_galleryMessageLabel->setStyleSheet("background-color: #474B5C; color: #999; font-size: 16px; padding: 50px;");
+
+    mainLayout->addWidget(m_galleryView);
+    mainLayout->addWidget(m_galleryMessageLabel);
+    showGalleryMessage("이미지 요청 버튼을 눌러 해당 시간대의 이미지를 불러오세요.");
 
     m_tabWidget->addTab(m_capturedImageTab, "Captured Images");
 }
@@ -613,7 +686,6 @@ void MainWindow::setupNetworkConnection()
         connect(m_tcpCommunicator, &TcpCommunicator::disconnected, this, &MainWindow::onTcpDisconnected);
         connect(m_tcpCommunicator, &TcpCommunicator::errorOccurred, this, &MainWindow::onTcpError);
         connect(m_tcpCommunicator, &TcpCommunicator::messageReceived, this, &MainWindow::onTcpDataReceived);
-        connect(m_tcpCommunicator, &TcpCommunicator::imagesReceived, this, &MainWindow::onImagesReceived);
 
         // 새로운 JSON 기반 시그널 연결
         connect(m_tcpCommunicator, &TcpCommunicator::coordinatesConfirmed, this, &MainWindow::onCoordinatesConfirmed);
@@ -636,12 +708,6 @@ void MainWindow::setupNetworkConnection()
                 });
     }
 
-    // 이미지 요청 타임아웃 타이머 설정
-    m_requestTimeoutTimer = new QTimer(this);
-    m_requestTimeoutTimer->setSingleShot(true);
-    m_requestTimeoutTimer->setInterval(30000);
-    connect(m_requestTimeoutTimer, &QTimer::timeout, this, &MainWindow::onRequestTimeout);
-
     m_imageViewerDialog = new ImageViewerDialog(this);
     m_imageViewerDialog->setWindowFlags(Qt::Window | Qt::FramelessWindowHint);
 }
@@ -654,80 +720,32 @@ void MainWindow::applyStyles()
 
 void MainWindow::clearImageGrid()
 {
-    QLayoutItem *item;
-    while ((item = m_imageGridLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
-    }
+    m_thumbnailCache->cancelPending();
+    m_galleryModel->clear();
+    m_galleryMessageLabel->hide();
+    m_galleryView->show();
 }
 
-void MainWindow::displayImages(const QList<ImageData> &images)
+void MainWindow::showGalleryMessage(const QString &message)
 {
-    clearImageGrid();
+    m_galleryModel->clear();
+    m_galleryView->hide();
+    m_galleryMessageLabel->setText(message);
+    m_galleryMessageLabel->show();
+}
 
+void MainWindow::displayImages(const QList<ImageData> &images)
+{
     if (images.isEmpty()) {
-        QLabel *emptyLabel = new QLabel("해당 시간대에 캡처된 이미지가 없습니다.");
-        emptyLabel->setAlignment(Qt::AlignCenter);
-        emptyLabel->setStyleSheet("color: #999; font-size: 16px; padding: 50px;");
-        m_imageGridLayout->addWidget(emptyLabel, 0, 0, 1, 2);
+        showGalleryMessage("해당 시간대에 캡처된 이미지가 없습니다.");
         return;
     }
 
-    int row = 0;
-    int col = 0;
-
-    for (const ImageData &imageData : images) {
-        ClickableImageLabel *imageLabel = new ClickableImageLabel();
-        imageLabel->setFixedSize(300, 200);
-        imageLabel->setScaledContents(true);
-        imageLabel->setImageData(imageData.imagePath, imageData.timestamp, imageData.logText);
-        imageLabel->setStyleSheet("border: none; padding: 2px; margin:0px");
-
-        QPixmap pixmap;
-        if (pixmap.load(imageData.imagePath)) {
-            imageLabel->setPixmap(pixmap);
-        } else {
-            imageLabel->setText("이미지 로드 실패");
-            imageLabel->setStyleSheet(imageLabel->styleSheet() + " color: #999;");
-        }
-
-        QLabel *timeLabel = new QLabel(imageData.timestamp);
-        timeLabel->setAlignment(Qt::AlignCenter);
-        timeLabel->setStyleSheet("background-color: #383A41; color: white; padding: 5px; font-size: 12px;");
-
-        QWidget *container = new QWidget();
-        container->setFixedSize(320, 240);
-
-        // 이미지 스타일 적용
-        container->setStyleSheet(
-            "background-color: #383A41;"
-            "border-radius: 10px;"
-            "padding: 5px;"
-            );
-        QVBoxLayout *containerLayout = new QVBoxLayout(container);
-        containerLayout->setContentsMargins(5, 5, 5, 5);
-        containerLayout->setSpacing(8);
-
-        //가운데 정렬
-        containerLayout->addStretch(1);          // 위쪽 여백
-        containerLayout->addWidget(imageLabel, 0, Qt::AlignHCenter);
-        containerLayout->addStretch(1);          // 아래쪽 여백
-        containerLayout->addWidget(timeLabel, 0, Qt::AlignHCenter);
-        connect(imageLabel, &ClickableImageLabel::clicked, this, &MainWindow::onImageClicked);
-
-        m_imageGridLayout->addWidget(container, row, col);
-
-        col++;
-        if (col >= 2) {
-            col = 0;
-            row++;
-        }
-    }
-
-    m_imageGridWidget->adjustSize();
+    clearImageGrid();
+    m_galleryModel->setImages(images);
+    m_galleryView->scrollToTop();
 }
 
-
 void MainWindow::onNetworkConfigClicked()
 {
     if (!m_networkDialog) {
@@ -736,6 +754,15 @@ void MainWindow::onNetworkConfigClicked()
         m_networkDialog->setRtspUrl(m_rtspUrl);
         m_networkDialog->setTcpHost(m_tcpHost);
         m_networkDialog->setTcpPort(m_tcpPort);
+
+        if (m_tcpCommunicator) {
+            connect(m_tcpCommunicator, &TcpCommunicator::connectionStateChanged,
+                    m_networkDialog, &NetworkConfigDialog::onConnectionStateChanged, Qt::UniqueConnection);
+        }
+    }
+
+    if (m_tcpCommunicator) {
+        m_networkDialog->onConnectionStateChanged(m_tcpCommunicator->connectionState());
     }
 
     if (m_networkDialog->exec() == QDialog::Accepted) {
@@ -757,7 +784,7 @@ void MainWindow::onNetworkConfigClicked()
 
 void MainWindow::onVideoStreamClicked()
 {
-    if (!m_videoStreamWidget->isStreaming()) {
+    if (!m_videoStreamWidget->isStreaming() && !(m_cameraGrid && m_cameraGrid->isStreaming())) {
         CustomMessageBox msgBox(nullptr, "안내", "먼저 스트리밍을 시작해주세요.");
         msgBox.setFixedSize(300,150);
         msgBox.exec();
@@ -863,6 +890,7 @@ void MainWindow::onDateButtonClicked()
 {
     if (m_calendarDialog) {
         m_calendarWidget->setSelectedDate(m_selectedDate);
+        requestMonthCounts(m_calendarWidget->yearShown(), m_calendarWidget->monthShown());
         m_calendarDialog->exec();
     }
 }
@@ -874,12 +902,90 @@ void MainWindow::onCalendarDateSelected(const QDate &date)
     m_calendarDialog->accept();
 
     qDebug() << "달력에서 날짜 선택:" << date.toString("yyyy-MM-dd");
+    requestHourCounts();
 }
 
 void MainWindow::onHourComboChanged(int index)
 {
     int selectedHour = m_hourComboBox->itemData(index).toInt();
     qDebug() << "시간 변경:" << QString("%1시~%2시").arg(selectedHour).arg(selectedHour + 1);
+    if (m_hourHeatStrip) {
+        m_hourHeatStrip->setCurrentHour(selectedHour);
+    }
+}
+
+void MainWindow::requestHourCounts()
+{
+    if (!m_hourComboBox || !m_hourHeatStrip) {
+        return;     // UI 구성 중 (날짜 위젯 초기값 설정)
+    }
+    if (m_hourCountRequest) {
+        m_hourCountRequest->cancel();
+    }
+    applyHourCounts(QList<int>());
+    m_hourCountsDate = QDate();
+
+    if (!m_tcpCommunicator) {
+        return;
+    }
+    PendingRequest *request = m_tcpCommunicator->requestCaptureCounts(m_selectedDate, TcpCommunicator::CountRange::Day);
+    if (!request) {
+        return;
+    }
+    m_hourCountRequest = request;
+    connect(request, &PendingRequest::finished, this, [this, request, date = m_selectedDate]() {
+        if (request->counts().size() == 24) {
+            applyHourCounts(request->counts());
+            m_hourCountsDate = date;
+        }
+    });
+}
+
+void MainWindow::applyHourCounts(const QList<int> &counts)
+{
+    // 콤보 항목에 건수를 붙이고 빈 시간은 고를 수 없게 (건수를 모르면 모두 선택 가능)
+    const QStandardItemModel *model = qobject_cast<const QStandardItemModel *>(m_hourComboBox->model());
+    for (int i = 0; i < m_hourComboBox->count(); ++i) {
+        const int h = m_hourComboBox->itemData(i).toInt();
+        QString text = QString("%1시 ~ %2시").arg(h, 2, 10, QChar('0')).arg(h + 1, 2, 10, QChar('0'));
+        if (!counts.isEmpty()) {
+            text += QString(" (%1)").arg(counts.value(h));
+        }
+        m_hourComboBox->setItemText(i, text);
+        if (model) {
+            model->item(i)->setEnabled(counts.isEmpty() || counts.value(h) > 0);
+        }
+    }
+    m_hourHeatStrip->setCounts(counts);
+}
+
+void MainWindow::requestMonthCounts(int year, int month)
+{
+    if (m_monthCountRequest) {
+        m_monthCountRequest->cancel();
+    }
+    m_calendarWidget->setDateTextFormat(QDate(), QTextCharFormat());
+
+    if (!m_tcpCommunicator) {
+        return;
+    }
+    const QDate firstDay(year, month, 1);
+    PendingRequest *request = m_tcpCommunicator->requestCaptureCounts(firstDay, TcpCommunicator::CountRange::Month);
+    if (!request) {
+        return;
+    }
+    m_monthCountRequest = request;
+    connect(request, &PendingRequest::finished, this, [this, request, firstDay]() {
+        const QList<int> &counts = request->counts();
+        const int maxCount = counts.isEmpty() ? 0 : *std::max_element(counts.cbegin(), counts.cend());
+        for (int day = 0; day < counts.size() && day < firstDay.daysInMonth(); ++day) {
+            QTextCharFormat format;
+            format.setBackground(CaptureHeatStrip::heatColor(counts[day], maxCount));
+            format.setForeground(counts[day] > 0 ? QColor(Qt::white) : QColor("#777777"));
+            format.setToolTip(QString("%1건").arg(counts[day]));
+            m_calendarWidget->setDateTextFormat(firstDay.addDays(day), format);
+        }
+    });
 }
 
 void MainWindow::onStreamingButtonClicked()
@@ -918,19 +1024,115 @@ void MainWindow::onRequestImagesClicked()
     int selectedHour = m_hourComboBox->currentData().toInt();
     QString dateString = m_selectedDate.toString("yyyy-MM-dd");
 
-    // m_statusLabel->setText("이미지 요청 중... (60초 후 타임아웃)");
-    // m_requestButton->setEnabled(false);
+    // 이전 조회가 아직 진행 중이면 취소 (늦게 오는 응답은 파싱 전에 버려진다)
+    if (m_imageRequest) {
+        m_imageRequest->cancel();
+    }
+
+    // 새 조회는 첫 페이지부터
+    m_galleryDate = dateString;
+    m_galleryHour = selectedHour;
+    m_galleryCursor.clear();
+    m_galleryHasMore = true;
+    m_galleryStreaming = false;
+
+    // 건수를 아는 빈 시간대는 서버에 묻지 않는다 (스크롤해도 이전 조회의 다음 페이지를 이어 받지 않도록 페이지 상태는 위에서 초기화)
+    // 건수가 아직 이전 날짜 것이면 믿지 않고 서버에 묻는다
+    const QList<int> hourCounts = m_hourCountsDate == m_selectedDate ? m_hourHeatStrip->counts() : QList<int>();
+    if (!hourCounts.isEmpty() && hourCounts.value(selectedHour) == 0) {
+        m_galleryHasMore = false;
+        displayImages(QList<ImageData>());
+        return;
+    }
 
-    // 타임아웃을 60초로 증가
-    // m_requestTimeoutTimer->setInterval(60000);
-    // m_requestTimeoutTimer->start();
+    // 앞뒤 시간을 보다가 넘어온 경우 미리 받아 둔 첫 페이지를 바로 보여줌
+    HourPrefetcher::Page prefetched;
+    if (m_hourPrefetcher && m_hourPrefetcher->take(m_selectedDate, selectedHour, prefetched)) {
+        qDebug() << QString("미리 받은 페이지 사용: %1개").arg(prefetched.images.size());
+        m_galleryHasMore = prefetched.hasMore;
+        m_galleryCursor = prefetched.cursor;
+        m_galleryStreaming = true;
+        displayImages(prefetched.images);
+        onGalleryScrolled();
+    } else {
+        requestNextImagePage();
+    }
 
-    // JSON 기반 이미지 요청
-    m_tcpCommunicator->requestImageData(dateString, selectedHour);
+    if (m_hourPrefetcher) {
+        m_hourPrefetcher->prefetchAround(m_selectedDate, selectedHour, m_galleryPageSize,
+                                         m_galleryMetadataFirst ? TcpCommunicator::ImageDetail::Thumbnail
+                                                                : TcpCommunicator::ImageDetail::Full,
+                                         hourCounts);
+    }
 
     qDebug() << QString("JSON 이미지 요청: %1, %2시~%3시").arg(dateString).arg(selectedHour).arg(selectedHour + 1);
 }
 
+void MainWindow::requestNextImagePage()
+{
+    if (!m_galleryHasMore || (m_imageRequest && m_imageRequest->isPending()) || !m_tcpCommunicator) {
+        return;
+    }
+
+    // 사용자가 기다리는 요청이 먼저 - 진행 중인 미리 받기는 취소했다가 나중에 다시
+    if (m_hourPrefetcher) {
+        m_hourPrefetcher->yieldToForeground();
+    }
+
+    // JSON 기반 이미지 요청 - 요청마다 개별 마감 시간을 가진 핸들
+    const bool firstPage = m_galleryCursor.isEmpty();
+    PendingRequest *request = m_tcpCommunicator->requestImagePage(
+        m_galleryDate, m_galleryHour, m_galleryCursor, m_galleryPageSize,
+        m_galleryMetadataFirst ? TcpCommunicator::ImageDetail::Thumbnail : TcpCommunicator::ImageDetail::Full);
+    if (!request) {
+        m_galleryHasMore = false;
+        return;
+    }
+
+    m_imageRequest = request;
+
+    // 캐시에 있던 이미지와 서버에서 받은 이미지가 도착하는 대로 하나씩 오므로 첫 이미지부터 갤러리를 채운다
+    connect(request, &PendingRequest::imageReceived, this, [this](const ImageData &image) {
+        if (!m_galleryStreaming) {
+            m_galleryStreaming = true;
+            clearImageGrid();
+        }
+        m_galleryModel->append(image);
+    });
+    connect(request, &PendingRequest::finished, this, [this, request, firstPage]() {
+        m_galleryHasMore = request->hasMore();
+        if (!request->nextCursor().isEmpty()) {
+            m_galleryCursor = request->nextCursor();
+        }
+        qDebug() << QString("이미지 페이지 수신: %1개, 누적 %2개, 다음 페이지: %3")
+                        .arg(request->images().size()).arg(m_galleryModel->rowCount())
+                        .arg(m_galleryHasMore ? m_galleryCursor : "없음");
+
+        if (firstPage && !m_galleryStreaming) {
+            onImagesReceived(request->images());
+        } else {
+            m_requestButton->setEnabled(true);
+        }
+
+        // 첫 페이지가 화면을 다 채우지 못했으면 바로 다음 페이지
+        onGalleryScrolled();
+    });
+    connect(request, &PendingRequest::timedOut, this, &MainWindow::onRequestTimeout);
+    connect(request, &PendingRequest::failed, this, [this](const QString &reason) {
+        qDebug() << "이미지 요청 실패:" << reason;
+        m_galleryHasMore = false;
+    });
+}
+
+void MainWindow::onGalleryScrolled()
+{
+    // 남은 스크롤이 한 화면 이하이면 (또는 화면이 아직 다 차지 않았으면) 다음 페이지를 미리 요청
+    const QScrollBar *scrollBar = m_galleryView->verticalScrollBar();
+    if (m_galleryHasMore && scrollBar->maximum() - scrollBar->value() <= m_galleryView->viewport()->height()) {
+        requestNextImagePage();
+    }
+}
+
 void MainWindow::onTcpConnected()
 {
     m_isConnected = true;
@@ -940,6 +1142,8 @@ void MainWindow::onTcpConnected()
         m_requestButton->setEnabled(true);
     }
 
+    // 선택한 날의 시간별 건수부터 받아 둔다 (이미지는 받지 않음)
+    requestHourCounts();
 
     CustomMessageBox msgBox(nullptr, "연결 성공", "TCP 서버에 성공적으로 연결되었습니다.");
     msgBox.setFixedSize(300,150);
@@ -958,6 +1162,17 @@ void MainWindow::onTcpDisconnected()
 
 }
 
+void MainWindow::onTcpConnectionStateChanged(TcpCommunicator::ConnectionState state)
+{
+    qDebug() << "TCP 연결 상태:" << TcpCommunicator::connectionStateToString(state);
+
+    // 이미지 요청은 TLS 핸드셰이크까지 끝난 뒤에만 허용
+    m_isConnected = (state == TcpCommunicator::ConnectionState::Ready);
+    if (m_requestButton) {
+        m_requestButton->setEnabled(m_isConnected);
+    }
+}
+
 void MainWindow::onTcpError(const QString &error)
 {
     qDebug() << "TCP 에러:" << error;
@@ -986,20 +1201,66 @@ void MainWindow::onImagesReceived(const QList<ImageData> &images)
 {
     qDebug() << QString("이미지 리스트 수신: %1개").arg(images.size());
 
-    if (m_requestTimeoutTimer->isActive()) {
-        m_requestTimeoutTimer->stop();
-    }
-
     displayImages(images);
 
     m_requestButton->setEnabled(true);
 }
 
-void MainWindow::onImageClicked(const QString &imagePath, const QString &timestamp, const QString &logText)
+void MainWindow::onGalleryItemClicked(const QModelIndex &index)
+{
+    if (index.isValid()) {
+        onImageClicked(m_galleryModel->imageAt(index.row()));
+    }
+}
+
+void MainWindow::onImageClicked(const ImageData &imageData)
 {
-    QPixmap pixmap;
-    if (pixmap.load(imagePath)) {
-        m_imageViewerDialog->setImage(pixmap, timestamp, logText);
+    if (!imageData.thumbnailOnly) {
+        showImageViewer(imageData);
+        return;
+    }
+
+    // 목록에는 썸네일만 있으므로 원본은 지금 받는다 (캡처 캐시에 있으면 서버 왕복 없음)
+    if (!m_tcpCommunicator) {
+        return;
+    }
+    if (m_fullImageRequest) {
+        m_fullImageRequest->cancel();
+    }
+
+    PendingRequest *request = m_tcpCommunicator->requestFullImage(imageData);
+    if (!request) {
+        return;
+    }
+    m_fullImageRequest = request;
+
+    connect(request, &PendingRequest::finished, this, [this, request, imageData]() {
+        if (request->images().isEmpty()) {
+            showImageViewer(ImageData());
+            return;
+        }
+        // 원본 응답에 메타데이터가 없으면 목록에서 받은 값을 유지
+        ImageData fullImage = request->images().first();
+        fullImage.detectionType = imageData.detectionType;
+        fullImage.direction = imageData.direction;
+        fullImage.lineIndex = imageData.lineIndex;
+        showImageViewer(fullImage);
+    });
+    connect(request, &PendingRequest::timedOut, this, &MainWindow::onRequestTimeout);
+    connect(request, &PendingRequest::failed, this, [this](const QString &reason) {
+        qDebug() << "원본 이미지 요청 실패:" << reason;
+        showImageViewer(ImageData());
+    });
+}
+
+void MainWindow::showImageViewer(const ImageData &imageData)
+{
+    // 전체 해상도 디코드와 확대용 피라미드는 뷰어가 작업 스레드에서 만든다
+    if (!imageData.image.isNull()) {
+        m_imageViewerDialog->setImage(imageData.image, imageData.timestamp, imageData.logText);
+        m_imageViewerDialog->exec();
+    } else if (ThumbnailCache::canRead(imageData.encodedData)) {
+        m_imageViewerDialog->setEncodedImage(imageData.encodedData, imageData.timestamp, imageData.logText);
         m_imageViewerDialog->exec();
     } else {
         CustomMessageBox msgBox(nullptr, "이미지 로드 오류", "이미지를 불러올 수 없습니다.");
@@ -1015,13 +1276,13 @@ void MainWindow::updateLogDisplay()
 
 void MainWindow::onRequestTimeout()
 {
-    qDebug() << "이미지 요청 타임아웃 (60초)";
+    qDebug() << "이미지 요청 타임아웃 (" << TcpCommunicator::DefaultRequestTimeoutMs / 1000 << "초)";
 
 
     m_requestButton->setEnabled(m_isConnected);
 
     CustomMessageBox msgBox(nullptr, "요청 타임아웃",
-                            "서버에서 60초 내에 응답이 없습니다.\n"
+                            QString("서버에서 %1초 내에 응답이 없습니다.\n").arg(TcpCommunicator::DefaultRequestTimeoutMs / 1000) +
                             "서버 상태와 네트워크 연결을 확인하고 다시 시도해주세요.");
     msgBox.setFixedSize(300,150);
     msgBox.exec();
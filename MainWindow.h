@@ -18,32 +18,20 @@
 #include <QCalendarWidget>
 #include <QDialog>
 #include <QMouseEvent>
+#include <QPointer>
+#include <QListView>
 
 #include "VideoStreamWidget.h"
+#include "CameraGridWidget.h"
 #include "TcpCommunicator.h"
+#include "PendingRequest.h"
 #include "ImageViewerDialog.h"
 #include "NetworkConfigDialog.h"
 #include "LineDrawingDialog.h"
-
-// 클릭 가능한 이미지 라벨 클래스
-class ClickableImageLabel : public QLabel
-{
-    Q_OBJECT
-
-public:
-    explicit ClickableImageLabel(QWidget *parent = nullptr);
-    void setImageData(const QString &imagePath, const QString &timestamp, const QString &logText);
-
-signals:
-    void clicked(const QString &imagePath, const QString &timestamp, const QString &logText);
-protected:
-    void mousePressEvent(QMouseEvent *event) override;
-
-private:
-    QString m_imagePath;
-    QString m_timestamp;
-    QString m_logText;
-};
+#include "ThumbnailCache.h"
+#include "CaptureGalleryModel.h"
+#include "CaptureHeatStrip.h"
+#include "HourPrefetcher.h"
 
 class MainWindow : public QMainWindow
 {
@@ -69,11 +57,15 @@ private slots:
     void onRequestImagesClicked();
     void onTcpConnected();
     void onTcpDisconnected();
+    void onTcpConnectionStateChanged(TcpCommunicator::ConnectionState state);
     void onTcpError(const QString &error);
     void onTcpDataReceived(const QString &data);
     void onTcpPacketReceived(int requestId, int success, const QString &data1, const QString &data2, const QString &data3);
     void onImagesReceived(const QList<ImageData> &images);
-    void onImageClicked(const QString &imagePath, const QString &timestamp, const QString &logText);
+    void onImageClicked(const ImageData &imageData);
+    void showImageViewer(const ImageData &imageData);
+    void onGalleryItemClicked(const QModelIndex &index);
+    void onGalleryScrolled();
     void updateLogDisplay();
     void onRequestTimeout();
     void onStreamError(const QString &error);
@@ -91,6 +83,11 @@ private:
     void updateWarningButtonStyles();
     void clearImageGrid();
     void displayImages(const QList<ImageData> &images);
+    void showGalleryMessage(const QString &message);
+    void requestNextImagePage();
+    void requestHourCounts();
+    void requestMonthCounts(int year, int month);
+    void applyHourCounts(const QList<int> &counts);
     void sendMultipleLineCoordinates(const QList<QPair<QPoint, QPoint>> &lines);
     void sendSingleLineCoordinates(int x1, int y1, int x2, int y2);
     void sendCategorizedCoordinates(const QList<RoadLineData> &roadLines, const QList<DetectionLineData> &detectionLines);
@@ -103,17 +100,32 @@ private:
     // Live Video Tab
     QWidget *m_liveVideoTab;
     VideoStreamWidget *m_videoStreamWidget;
+    CameraGridWidget *m_cameraGrid;         // RTSP_URLS 에 카메라가 여러 대일 때만 (아니면 nullptr)
     QPushButton *m_streamingButton;
 
     // Captured Image Tab
     QWidget *m_capturedImageTab;
-    QScrollArea *m_imageScrollArea;
-    QWidget *m_imageGridWidget;
-    QGridLayout *m_imageGridLayout;
+    QListView *m_galleryView;               // 보이는 칸만 그리는 가상화 갤러리
+    CaptureGalleryModel *m_galleryModel;
+    QLabel *m_galleryMessageLabel;          // 결과가 없을 때 안내 문구
+    bool m_galleryStreaming;        // 현재 조회의 이미지를 받기 시작함 (첫 이미지에서 갤러리를 비움)
+    // 페이지 조회 상태 (스크롤이 끝에 가까워지면 다음 페이지 요청)
+    QString m_galleryDate;
+    int m_galleryHour;
+    QString m_galleryCursor;
+    bool m_galleryHasMore;
+    int m_galleryPageSize;
+    bool m_galleryMetadataFirst;            // 목록은 메타데이터 + 썸네일만, 원본은 열 때 받음
+    ThumbnailCache *m_thumbnailCache;
+    HourPrefetcher *m_hourPrefetcher;       // 앞뒤 시간대 첫 페이지 미리 받기 (꺼져 있으면 nullptr)
     QPushButton *m_dateButton;
     QCalendarWidget *m_calendarWidget;
     QDialog *m_calendarDialog;
     QComboBox *m_hourComboBox;
+    CaptureHeatStrip *m_hourHeatStrip;      // 선택한 날의 시간별 캡처 건수
+    QPointer<PendingRequest> m_hourCountRequest;
+    QDate m_hourCountsDate;                 // m_hourHeatStrip 건수가 어느 날 것인지 (모르면 무효)
+    QPointer<PendingRequest> m_monthCountRequest;
     QDateEdit *m_dateEdit;
     QSpinBox *m_hourSpinBox;
     QPushButton *m_requestButton;
@@ -134,7 +146,8 @@ private:
     TcpCommunicator *m_tcpCommunicator;
     QNetworkAccessManager *m_networkManager;
     QTimer *m_updateTimer;
-    QTimer *m_requestTimeoutTimer;
+    QPointer<PendingRequest> m_imageRequest;   // 진행 중인 이미지 조회 (요청별 마감 시간)
+    QPointer<PendingRequest> m_fullImageRequest;   // 뷰어로 열 원본 이미지 요청
 
     // 다이얼로그
     ImageViewerDialog *m_imageViewerDialog;
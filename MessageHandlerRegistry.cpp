@@ -0,0 +1,94 @@
+#include "MessageHandlerRegistry.h"
+#include <QDebug>
+
+MessageHandlerRegistry::MessageHandlerRegistry()
+    : m_nextId(1)
+{
+}
+
+int MessageHandlerRegistry::add(int requestId, QObject *context, Handler handler)
+{
+    if (!context || !handler) {
+        return 0;
+    }
+
+    Entry entry;
+    entry.id = m_nextId++;
+    entry.context = context;
+    entry.handler = std::move(handler);
+    m_handlers[requestId].append(entry);
+
+    qDebug() << "[Handler] 등록 - request_id:" << requestId << "handler:" << entry.id;
+    return entry.id;
+}
+
+void MessageHandlerRegistry::remove(int handlerId)
+{
+    for (auto it = m_handlers.begin(); it != m_handlers.end();) {
+        it.value().removeIf([handlerId](const Entry &entry) { return entry.id == handlerId; });
+        it = it.value().isEmpty() ? m_handlers.erase(it) : std::next(it);
+    }
+}
+
+void MessageHandlerRegistry::removeAll(const QObject *context)
+{
+    for (auto it = m_handlers.begin(); it != m_handlers.end();) {
+        it.value().removeIf([context](const Entry &entry) {
+            return entry.context.isNull() || entry.context.data() == context;
+        });
+        it = it.value().isEmpty() ? m_handlers.erase(it) : std::next(it);
+    }
+}
+
+bool MessageHandlerRegistry::dispatch(int requestId, const QJsonObject &message)
+{
+    auto it = m_handlers.constFind(requestId);
+    if (it == m_handlers.constEnd()) {
+        return false;
+    }
+
+    // 핸들러 안에서 등록/해제가 일어날 수 있으므로 복사본으로 순회
+    const QList<Entry> entries = it.value();
+    bool handled = false;
+    bool stale = false;
+
+    for (const Entry &entry : entries) {
+        if (entry.context.isNull()) {
+            stale = true;
+            continue;
+        }
+        entry.handler(message);
+        handled = true;
+    }
+
+    if (stale) {
+        prune(requestId);
+    }
+    return handled;
+}
+
+bool MessageHandlerRegistry::contains(int requestId) const
+{
+    auto it = m_handlers.constFind(requestId);
+    if (it == m_handlers.constEnd()) {
+        return false;
+    }
+    for (const Entry &entry : it.value()) {
+        if (!entry.context.isNull()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MessageHandlerRegistry::prune(int requestId)
+{
+    auto it = m_handlers.find(requestId);
+    if (it == m_handlers.end()) {
+        return;
+    }
+    it.value().removeIf([](const Entry &entry) { return entry.context.isNull(); });
+    if (it.value().isEmpty()) {
+        m_handlers.erase(it);
+    }
+}
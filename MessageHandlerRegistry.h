@@ -0,0 +1,43 @@
+#ifndef MESSAGEHANDLERREGISTRY_H
+#define MESSAGEHANDLERREGISTRY_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <functional>
+
+// request_id 별 수신 메시지 핸들러 등록부 (GUI 스레드)
+// 컴포넌트는 관심 있는 응답 id 에만 핸들러를 등록하고, 이미 파싱된 QJsonObject 를 한 번 받는다.
+// 핸들러마다 context 객체를 두며, context 가 삭제되면 해당 핸들러는 더 이상 호출되지 않는다.
+class MessageHandlerRegistry
+{
+public:
+    using Handler = std::function<void(const QJsonObject &)>;
+
+    MessageHandlerRegistry();
+
+    // 등록된 핸들러 id 를 돌려준다 (remove 에 사용)
+    int add(int requestId, QObject *context, Handler handler);
+    void remove(int handlerId);
+    void removeAll(const QObject *context);
+
+    // requestId 에 등록된 핸들러를 모두 호출, 호출된 핸들러가 없으면 false
+    bool dispatch(int requestId, const QJsonObject &message);
+    bool contains(int requestId) const;
+
+private:
+    struct Entry {
+        int id = 0;
+        QPointer<QObject> context;
+        Handler handler;
+    };
+
+    void prune(int requestId);
+
+    QHash<int, QList<Entry>> m_handlers;
+    int m_nextId;
+};
+
+#endif // MESSAGEHANDLERREGISTRY_H
@@ -12,6 +12,7 @@ NetworkConfigDialog::NetworkConfigDialog(QWidget *parent)
     , m_rtspUrlEdit(nullptr)
     , m_tcpHostEdit(nullptr)
     , m_tcpPortEdit(nullptr)
+    , m_connectionStatusLabel(nullptr)
 {
     setupUI();
     setWindowTitle("네트워크 설정");
@@ -68,6 +69,11 @@ void NetworkConfigDialog::setupUI()
     m_tcpPortEdit->setValidator(portValidator);
     
     formLayout->addRow("TCP 포트:", m_tcpPortEdit);
+
+    // 연결 상태 표시
+    m_connectionStatusLabel = new QLabel("Disconnected");
+    m_connectionStatusLabel->setStyleSheet("color: #dc3545; font-weight: bold;");
+    formLayout->addRow("연결 상태:", m_connectionStatusLabel);
     
     mainLayout->addLayout(formLayout);
     
@@ -115,3 +121,22 @@ void NetworkConfigDialog::setTcpPort(int port)
 {
     m_tcpPortEdit->setText(QString::number(port));
 }
+
+void NetworkConfigDialog::onConnectionStateChanged(TcpCommunicator::ConnectionState state)
+{
+    QString color;
+    switch (state) {
+    case TcpCommunicator::ConnectionState::Ready:
+        color = "#28a745";
+        break;
+    case TcpCommunicator::ConnectionState::Disconnected:
+        color = "#dc3545";
+        break;
+    default:
+        color = "#ffc107";
+        break;
+    }
+
+    m_connectionStatusLabel->setText(TcpCommunicator::connectionStateToString(state));
+    m_connectionStatusLabel->setStyleSheet(QString("color: %1; font-weight: bold;").arg(color));
+}
@@ -3,6 +3,9 @@
 
 #include <QDialog>
 #include <QLineEdit>
+#include <QLabel>
+
+#include "TcpCommunicator.h"
 
 class NetworkConfigDialog : public QDialog
 {
@@ -21,12 +24,17 @@ public:
     int getTcpPort() const;
     void setTcpPort(int port);
 
+public slots:
+    // 현재 TCP 연결 단계를 표시
+    void onConnectionStateChanged(TcpCommunicator::ConnectionState state);
+
 private:
     void setupUI();
 
     QLineEdit *m_rtspUrlEdit;
     QLineEdit *m_tcpHostEdit;
     QLineEdit *m_tcpPortEdit;
+    QLabel *m_connectionStatusLabel;
 };
 
 #endif // NETWORKCONFIGDIALOG_H
@@ -0,0 +1,331 @@
+#include "PayloadCodec.h"
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <limits>
+
+namespace {
+// CBOR 정수 키 테이블 (KeyTableVersion 1) - 서버와 동일해야 함, 번호는 재사용하지 않는다
+struct KeyEntry {
+    int id;
+    const char *name;
+};
+
+const KeyEntry kKeyTable[] = {
+    { 1, "request_id" },
+    { 2, "response_id" },
+    { 3, "seq" },
+    { 4, "data" },
+    { 5, "timestamp" },
+    { 6, "message" },
+    { 7, "success" },
+    { 8, "bboxes" },
+    { 9, "id" },
+    { 10, "type" },
+    { 11, "confidence" },
+    { 12, "x" },
+    { 13, "y" },
+    { 14, "width" },
+    { 15, "height" },
+    { 16, "index" },
+    { 17, "x1" },
+    { 18, "y1" },
+    { 19, "x2" },
+    { 20, "y2" },
+    { 21, "matrixNum1" },
+    { 22, "matrixNum2" },
+    { 23, "name" },
+    { 24, "mode" },
+    { 25, "image" },
+    { 26, "start_timestamp" },
+    { 27, "end_timestamp" },
+};
+
+const QHash<QString, int> &keyIds()
+{
+    static const QHash<QString, int> ids = [] {
+        QHash<QString, int> table;
+        for (const KeyEntry &entry : kKeyTable) {
+            table.insert(QString::fromLatin1(entry.name), entry.id);
+        }
+        return table;
+    }();
+    return ids;
+}
+
+const QHash<qint64, QString> &keyNames()
+{
+    static const QHash<qint64, QString> names = [] {
+        QHash<qint64, QString> table;
+        for (const KeyEntry &entry : kKeyTable) {
+            table.insert(entry.id, QString::fromLatin1(entry.name));
+        }
+        return table;
+    }();
+    return names;
+}
+
+QCborValue toCbor(const QJsonValue &value);
+
+QCborMap toCborMap(const QJsonObject &object)
+{
+    const QHash<QString, int> &ids = keyIds();
+
+    QCborMap map;
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        auto id = ids.constFind(it.key());
+        if (id != ids.constEnd()) {
+            map.insert(static_cast<qint64>(id.value()), toCbor(it.value()));
+        } else {
+            map.insert(it.key(), toCbor(it.value()));
+        }
+    }
+    return map;
+}
+
+QCborValue toCbor(const QJsonValue &value)
+{
+    if (value.isObject()) {
+        return toCborMap(value.toObject());
+    }
+    if (value.isArray()) {
+        const QJsonArray array = value.toArray();
+        QCborArray cborArray;
+        for (const QJsonValue &element : array) {
+            cborArray.append(toCbor(element));
+        }
+        return cborArray;
+    }
+    return QCborValue::fromJsonValue(value);
+}
+
+QJsonValue toJson(const QCborValue &value);
+
+QJsonObject toJsonObject(const QCborMap &map)
+{
+    const QHash<qint64, QString> &names = keyNames();
+
+    QJsonObject object;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        const QCborValue key = it.key();
+        QString name;
+        if (key.isInteger()) {
+            name = names.value(key.toInteger(), QString::number(key.toInteger()));
+        } else {
+            name = key.toString();
+        }
+        object.insert(name, toJson(it.value()));
+    }
+    return object;
+}
+
+QJsonValue toJson(const QCborValue &value)
+{
+    switch (value.type()) {
+    case QCborValue::Map:
+        return toJsonObject(value.toMap());
+    case QCborValue::Array: {
+        const QCborArray cborArray = value.toArray();
+        QJsonArray array;
+        for (const QCborValue &element : cborArray) {
+            array.append(toJson(element));
+        }
+        return array;
+    }
+    case QCborValue::ByteArray:
+        // 이미지 등 바이너리 필드: 기존 파서가 Base64 문자열을 기대하므로 표준 Base64 로 맞춘다
+        return QString::fromLatin1(value.toByteArray().toBase64());
+    default:
+        return value.toJsonValue();
+    }
+}
+
+bool peekCborSeq(QByteArrayView payload, quint32 &seq)
+{
+    QCborStreamReader reader(QByteArray::fromRawData(payload.data(), payload.size()));
+    while (reader.isTag() && reader.next()) {
+    }
+    if (!reader.isMap() || !reader.enterContainer()) {
+        return false;
+    }
+
+    const qint64 seqKeyId = keyIds().value(QStringLiteral("seq"));
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        bool isSeqKey = false;
+        if (reader.isInteger()) {
+            isSeqKey = reader.toInteger() == seqKeyId;
+            reader.next();
+        } else if (reader.isString()) {
+            QString key;
+            auto chunk = reader.readString();
+            while (chunk.status == QCborStreamReader::Ok) {
+                key += chunk.data;
+                chunk = reader.readString();
+            }
+            if (chunk.status == QCborStreamReader::Error) {
+                return false;
+            }
+            isSeqKey = key == QLatin1String("seq");
+        } else {
+            reader.next();
+        }
+
+        if (isSeqKey) {
+            if (!reader.isUnsignedInteger() || reader.toUnsignedInteger() > std::numeric_limits<quint32>::max()) {
+                return false;
+            }
+            seq = static_cast<quint32>(reader.toUnsignedInteger());
+            return true;
+        }
+        // 값은 통째로 건너뜀 (이미지 바이트 등은 복사하지 않음)
+        reader.next();
+    }
+    return false;
+}
+
+bool peekJsonSeq(QByteArrayView payload, quint32 &seq)
+{
+    // 문자열 안의 괄호는 세지 않으면서 깊이를 따라가 최상위(깊이 1)의 "seq" 키만 본다
+    static const QByteArrayView key("seq");
+    int depth = 0;
+    for (qsizetype pos = 0; pos < payload.size(); ++pos) {
+        const char c = payload[pos];
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (--depth <= 0) {
+                return false;
+            }
+        } else if (c == '"') {
+            // 닫는 따옴표 찾기 (앞의 백슬래시가 홀수 개면 이스케이프)
+            const qsizetype start = pos + 1;
+            qsizetype end = start;
+            while (true) {
+                end = payload.indexOf('"', end);
+                if (end < 0) {
+                    return false;
+                }
+                qsizetype backslashes = 0;
+                while (payload[end - 1 - backslashes] == '\\') {
+                    ++backslashes;
+                }
+                if (backslashes % 2 == 0) {
+                    break;
+                }
+                ++end;
+            }
+            pos = end;
+
+            if (depth != 1 || end - start != key.size() || !payload.sliced(start).startsWith(key)) {
+                continue;
+            }
+            qsizetype value = end + 1;
+            while (value < payload.size() && (payload[value] == ' ' || payload[value] == '\t' ||
+                                              payload[value] == '\r' || payload[value] == '\n')) {
+                ++value;
+            }
+            if (value >= payload.size() || payload[value] != ':') {
+                continue;   // 키가 아니라 값 문자열
+            }
+            ++value;
+            while (value < payload.size() && payload[value] == ' ') {
+                ++value;
+            }
+
+            quint64 number = 0;
+            qsizetype digits = 0;
+            while (value < payload.size() && payload[value] >= '0' && payload[value] <= '9' && digits < 10) {
+                number = number * 10 + static_cast<quint64>(payload[value] - '0');
+                ++value;
+                ++digits;
+            }
+            if (digits == 0 || number > std::numeric_limits<quint32>::max()) {
+                return false;
+            }
+            seq = static_cast<quint32>(number);
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+PayloadCodec::Encoding PayloadCodec::detect(QByteArrayView payload)
+{
+    // JSON 객체는 '{' (앞 공백 허용), CBOR 는 map(0xA0~0xBF) 또는 태그(0xC0~0xDB)로 시작
+    for (const char c : payload) {
+        const uchar byte = static_cast<uchar>(c);
+        if (byte == ' ' || byte == '\t' || byte == '\r' || byte == '\n') {
+            continue;
+        }
+        return (byte >= 0xA0 && byte <= 0xDB) ? Encoding::Cbor : Encoding::Json;
+    }
+    return Encoding::Json;
+}
+
+QByteArray PayloadCodec::encode(const QJsonObject &message, Encoding encoding)
+{
+    if (encoding == Encoding::Cbor) {
+        return QCborValue(toCborMap(message)).toCbor();
+    }
+    return QJsonDocument(message).toJson(QJsonDocument::Compact);
+}
+
+bool PayloadCodec::decode(QByteArrayView payload, QJsonObject &message, QString *errorString)
+{
+    // 디코더 버퍼를 그대로 감싸서 파싱 (복사 없음)
+    const QByteArray data = QByteArray::fromRawData(payload.data(), payload.size());
+
+    if (detect(payload) == Encoding::Cbor) {
+        QCborParserError error;
+        const QCborValue value = QCborValue::fromCbor(data, &error);
+        if (error.error != QCborError::NoError || !value.isMap()) {
+            if (errorString) {
+                *errorString = error.error != QCborError::NoError ? error.errorString()
+                                                                  : QString("CBOR payload is not a map");
+            }
+            return false;
+        }
+        message = toJsonObject(value.toMap());
+        return true;
+    }
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (errorString) {
+            *errorString = error.error != QJsonParseError::NoError ? error.errorString()
+                                                                   : QString("JSON payload is not an object");
+        }
+        return false;
+    }
+    message = doc.object();
+    return true;
+}
+
+bool PayloadCodec::peekSeq(QByteArrayView payload, quint32 &seq)
+{
+    return detect(payload) == Encoding::Cbor ? peekCborSeq(payload, seq) : peekJsonSeq(payload, seq);
+}
+
+QString PayloadCodec::encodingName(Encoding encoding)
+{
+    return encoding == Encoding::Cbor ? QStringLiteral("cbor") : QStringLiteral("json");
+}
+
+bool PayloadCodec::encodingFromName(const QString &name, Encoding &encoding)
+{
+    if (name.compare("cbor", Qt::CaseInsensitive) == 0) {
+        encoding = Encoding::Cbor;
+        return true;
+    }
+    if (name.compare("json", Qt::CaseInsensitive) == 0) {
+        encoding = Encoding::Json;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,40 @@
+#ifndef PAYLOADCODEC_H
+#define PAYLOADCODEC_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QJsonObject>
+#include <QString>
+
+// 프레임 페이로드 인코딩 (JSON 텍스트 / CBOR)
+// CBOR 는 자주 쓰이는 키를 정수로 바꿔 보낸다 (아래 키 테이블, 서버와 같은 표를 공유).
+// 테이블에 없는 키는 문자열 그대로 보내므로 서버가 새 필드를 추가해도 깨지지 않는다.
+// 수신 시에는 첫 바이트로 인코딩을 판별하므로 협상 전후 프레임이 섞여도 된다.
+class PayloadCodec
+{
+public:
+    enum class Encoding {
+        Json,
+        Cbor
+    };
+
+    // 키 테이블 버전 - 능력 협상 시 서버에 알림 (테이블을 바꾸면 올린다)
+    static constexpr int KeyTableVersion = 1;
+
+    static Encoding detect(QByteArrayView payload);
+    static QByteArray encode(const QJsonObject &message, Encoding encoding);
+
+    // 인코딩을 자동 판별해 객체로 변환, 실패 시 errorString 에 이유를 담고 false
+    static bool decode(QByteArrayView payload, QJsonObject &message, QString *errorString = nullptr);
+
+    // 전체를 디코드하지 않고 최상위 객체의 seq 만 읽는다 (중첩된 객체의 seq 는 무시). 없으면 false
+    static bool peekSeq(QByteArrayView payload, quint32 &seq);
+
+    static QString encodingName(Encoding encoding);
+    static bool encodingFromName(const QString &name, Encoding &encoding);
+
+private:
+    PayloadCodec() = delete;
+};
+
+#endif // PAYLOADCODEC_H
@@ -0,0 +1,195 @@
+#include "PendingRequest.h"
+#include "ClockSync.h"
+#include <QDebug>
+#include <limits>
+
+PendingRequest::PendingRequest(PendingRequestTable *table, quint32 seq, int requestId, int responseId, qint64 deadlineMs)
+    : QObject(table)
+    , m_table(table)
+    , m_seq(seq)
+    , m_requestId(requestId)
+    , m_responseId(responseId)
+    , m_deadlineMs(deadlineMs)
+    , m_status(Status::Pending)
+    , m_cacheLoadsPending(0)
+    , m_pageSize(0)
+    , m_pageImageCount(0)
+    , m_moreCached(false)
+    , m_quiet(false)
+    , m_sentUs(0)
+    , m_receivedUs(0)
+{
+}
+
+void PendingRequest::cancel()
+{
+    if (isPending()) {
+        m_table->cancel(this);
+    }
+}
+
+PendingRequestTable::PendingRequestTable(QObject *parent)
+    : QObject(parent)
+    , m_deadlineTimer(new QTimer(this))
+    , m_nextSeq(1)
+{
+    m_deadlineTimer->setSingleShot(true);
+    connect(m_deadlineTimer, &QTimer::timeout, this, &PendingRequestTable::onDeadlineTimer);
+}
+
+quint32 PendingRequestTable::nextSeq()
+{
+    // 0 은 "seq 없음" 으로 쓰이므로 건너뜀
+    quint32 seq = m_nextSeq++;
+    if (seq == 0) {
+        seq = m_nextSeq++;
+    }
+    return seq;
+}
+
+PendingRequest *PendingRequestTable::add(int requestId, int responseId, int timeoutMs)
+{
+    const quint32 seq = nextSeq();
+    const qint64 deadlineMs = timeoutMs > 0 ? ClockSync::monotonicMs() + timeoutMs : 0;
+
+    PendingRequest *request = new PendingRequest(this, seq, requestId, responseId, deadlineMs);
+    m_requests.insert(seq, request);
+    rearmTimer();
+
+    qDebug() << "[Request] 등록 - seq:" << seq << "request_id:" << requestId
+             << "대기 중:" << m_requests.size();
+    return request;
+}
+
+PendingRequest *PendingRequestTable::find(quint32 seq, int responseId) const
+{
+    if (seq != 0) {
+        return m_requests.value(seq);
+    }
+
+    // seq 를 돌려주지 않는 서버: 같은 응답을 기다리는 가장 오래된 요청과 짝지음
+    PendingRequest *request = nullptr;
+    for (auto it = m_requests.constBegin(); it != m_requests.constEnd(); ++it) {
+        if (it.value()->responseId() == responseId &&
+            (!request || it.key() < request->seq())) {
+            request = it.value();
+        }
+    }
+    return request;
+}
+
+PendingRequest *PendingRequestTable::take(quint32 seq, int responseId)
+{
+    PendingRequest *request = find(seq, responseId);
+    if (request) {
+        m_requests.remove(request->seq());
+        rearmTimer();
+    }
+    return request;
+}
+
+void PendingRequestTable::complete(PendingRequest *request)
+{
+    finish(request, PendingRequest::Status::Finished);
+}
+
+void PendingRequestTable::fail(PendingRequest *request, const QString &reason)
+{
+    if (m_requests.remove(request->seq()) > 0) {
+        rearmTimer();
+    }
+    finish(request, PendingRequest::Status::Failed, reason);
+}
+
+void PendingRequestTable::cancel(PendingRequest *request)
+{
+    if (m_requests.remove(request->seq()) > 0) {
+        rearmTimer();
+        emit requestAbandoned(request->seq());
+    }
+    finish(request, PendingRequest::Status::Cancelled);
+}
+
+void PendingRequestTable::failAll(const QString &reason)
+{
+    if (m_requests.isEmpty()) {
+        return;
+    }
+
+    const QList<PendingRequest *> requests = m_requests.values();
+    m_requests.clear();
+    m_deadlineTimer->stop();
+
+    for (PendingRequest *request : requests) {
+        finish(request, PendingRequest::Status::Failed, reason);
+    }
+}
+
+void PendingRequestTable::finish(PendingRequest *request, PendingRequest::Status status, const QString &reason)
+{
+    if (!request->isPending()) {
+        return;
+    }
+
+    request->m_status = status;
+    switch (status) {
+    case PendingRequest::Status::Finished:
+        emit request->finished();
+        break;
+    case PendingRequest::Status::TimedOut:
+        emit request->timedOut();
+        break;
+    case PendingRequest::Status::Cancelled:
+        emit request->cancelled();
+        break;
+    case PendingRequest::Status::Failed:
+        emit request->failed(reason);
+        break;
+    case PendingRequest::Status::Pending:
+        break;
+    }
+
+    request->deleteLater();
+}
+
+void PendingRequestTable::onDeadlineTimer()
+{
+    const qint64 now = ClockSync::monotonicMs();
+
+    QList<PendingRequest *> expired;
+    for (auto it = m_requests.begin(); it != m_requests.end();) {
+        PendingRequest *request = it.value();
+        if (request->m_deadlineMs > 0 && request->m_deadlineMs <= now) {
+            expired.append(request);
+            it = m_requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    rearmTimer();
+
+    for (PendingRequest *request : expired) {
+        qDebug() << "[Request] 타임아웃 - seq:" << request->seq() << "request_id:" << request->requestId();
+        emit requestAbandoned(request->seq());
+        finish(request, PendingRequest::Status::TimedOut);
+    }
+}
+
+void PendingRequestTable::rearmTimer()
+{
+    qint64 earliest = std::numeric_limits<qint64>::max();
+    for (const PendingRequest *request : m_requests) {
+        if (request->m_deadlineMs > 0) {
+            earliest = qMin(earliest, request->m_deadlineMs);
+        }
+    }
+
+    if (earliest == std::numeric_limits<qint64>::max()) {
+        m_deadlineTimer->stop();
+        return;
+    }
+
+    const qint64 remaining = qMax<qint64>(0, earliest - ClockSync::monotonicMs());
+    m_deadlineTimer->start(static_cast<int>(qMin<qint64>(remaining, std::numeric_limits<int>::max())));
+}
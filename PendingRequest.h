@@ -0,0 +1,139 @@
+#ifndef PENDINGREQUEST_H
+#define PENDINGREQUEST_H
+
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QSet>
+#include <QSize>
+#include <QTimer>
+
+#include "TcpCommunicator.h"
+#include "CaptureCache.h"
+
+class PendingRequestTable;
+
+// 서버에 보낸 요청 하나에 대한 핸들
+// 요청마다 seq 가 붙어 전송되고, 서버가 응답에 같은 seq 를 돌려주면 이 핸들로 결과가 전달된다.
+// finished/timedOut/cancelled/failed 중 하나가 정확히 한 번 발생하며,
+// 그 뒤 이벤트 루프로 돌아가면 핸들은 삭제된다 (보관하려면 QPointer 사용).
+class PendingRequest : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Status {
+        Pending,
+        Finished,
+        TimedOut,
+        Cancelled,
+        Failed
+    };
+
+    quint32 seq() const { return m_seq; }
+    int requestId() const { return m_requestId; }
+    int responseId() const { return m_responseId; }
+    Status status() const { return m_status; }
+    bool isPending() const { return m_status == Status::Pending; }
+
+    // 응답 데이터 (request_id 에 따라 채워지는 항목이 다름)
+    const QList<ImageData> &images() const { return m_images; }
+    const QList<DetectionLineData> &detectionLines() const { return m_detectionLines; }
+    const QList<RoadLineData> &roadLines() const { return m_roadLines; }
+    const QJsonObject &reply() const { return m_reply; }
+    const QList<int> &counts() const { return m_counts; }      // 캡처 건수 집계 결과
+
+    // 단조 시각 (ClockSync::monotonicUs): 요청을 보낸 때와 응답이 I/O 스레드에 도착한 때 (응답 전에는 0)
+    qint64 sentUs() const { return m_sentUs; }
+    qint64 receivedUs() const { return m_receivedUs; }
+
+    // 페이지 조회 (requestImagePage) 결과: 서버에서 pageSize 만큼 받았으면 다음 페이지가 있을 수 있음
+    // (캐시에 이 페이지에 다 넣지 못한 이미지가 남은 경우도 포함)
+    bool hasMore() const { return m_pageSize > 0 && (m_pageImageCount >= m_pageSize || m_moreCached); }
+    const QString &nextCursor() const { return m_pageCursor; }
+
+public slots:
+    // 응답을 더 이상 기다리지 않음 - 늦게 도착한 응답은 파싱 전에 버려진다
+    void cancel();
+
+signals:
+    // 이미지 응답을 스트리밍으로 받을 때 이미지 하나가 도착할 때마다 (finished 전에 여러 번)
+    void imageReceived(const ImageData &image);
+    void finished();
+    void timedOut();
+    void cancelled();
+    void failed(const QString &reason);
+
+private:
+    friend class PendingRequestTable;
+    friend class TcpCommunicator;   // 응답 데이터 채움
+    PendingRequest(PendingRequestTable *table, quint32 seq, int requestId, int responseId, qint64 deadlineMs);
+
+    PendingRequestTable *m_table;
+    quint32 m_seq;
+    int m_requestId;
+    int m_responseId;
+    qint64 m_deadlineMs;                // ClockSync::monotonicMs 기준 (0 이면 마감 없음) - 시스템 시계 변경에 영향받지 않음
+    Status m_status;
+
+    QList<ImageData> m_images;
+    QSet<QString> m_imageKeys;          // 전달한 이미지 (카메라|타임스탬프|내용 해시) - 캐시/스트리밍/최종 응답 중복 제거
+    int m_cacheLoadsPending;            // 캡처 캐시에서 아직 읽는 중인 이미지 수
+    int m_pageSize;                     // 0 이면 페이지 조회 아님
+    int m_pageImageCount;               // 이 페이지에서 서버가 보낸 이미지 수 (캐시 제외)
+    QString m_pageCursor;               // 이 페이지의 마지막 타임스탬프 (다음 페이지는 이 뒤부터)
+    bool m_moreCached;                  // 페이지가 캐시 항목으로 찼음 - 서버 페이지가 덜 차도 다음 페이지가 있음
+    QList<CaptureCache::Entry> m_cachedCandidates;  // 커서 뒤의 캐시 항목 (시간순, 응답을 받은 뒤 페이지에 들 것만 전달)
+    QSize m_cacheThumbnailSize;         // 목록 조회면 캐시 원본을 이 크기로 줄여 전달
+    bool m_quiet;                       // 백그라운드 요청 - 화면 상태 시그널을 내지 않음
+    QList<DetectionLineData> m_detectionLines;
+    QList<RoadLineData> m_roadLines;
+    QJsonObject m_reply;
+    QList<int> m_counts;
+    qint64 m_sentUs;
+    qint64 m_receivedUs;
+};
+
+// seq → 대기 중인 요청 테이블 (GUI 스레드)
+// 요청마다 개별 마감 시간을 두고, 가장 이른 마감에 맞춰 타이머 하나만 돌린다.
+class PendingRequestTable : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PendingRequestTable(QObject *parent = nullptr);
+
+    PendingRequest *add(int requestId, int responseId, int timeoutMs);
+
+    // 응답과 짝지을 요청을 꺼낸다.
+    // seq 가 있으면 seq 로, 없으면 (구버전 서버) 같은 응답 id 를 기다리는 가장 오래된 요청
+    PendingRequest *take(quint32 seq, int responseId);
+    // take() 와 같은 규칙으로 찾기만 함 (스트리밍 중간 결과 전달용)
+    PendingRequest *find(quint32 seq, int responseId) const;
+
+    void complete(PendingRequest *request);
+    void fail(PendingRequest *request, const QString &reason);
+    void cancel(PendingRequest *request);
+    void failAll(const QString &reason);
+
+    int size() const { return m_requests.size(); }
+
+signals:
+    // 취소/타임아웃된 요청의 seq - 늦게 오는 응답을 I/O 스레드에서 버리기 위해 사용
+    void requestAbandoned(quint32 seq);
+
+private slots:
+    void onDeadlineTimer();
+
+private:
+    quint32 nextSeq();
+    void finish(PendingRequest *request, PendingRequest::Status status, const QString &reason = QString());
+    void rearmTimer();
+
+    QHash<quint32, PendingRequest *> m_requests;
+    QTimer *m_deadlineTimer;
+    quint32 m_nextSeq;
+};
+
+#endif // PENDINGREQUEST_H
@@ -0,0 +1,136 @@
+#include "ReconnectScheduler.h"
+#include <QDebug>
+#include <QRandomGenerator>
+#include <QtMath>
+
+namespace {
+// Reachability 백엔드는 프로세스 전체에서 한 번만 로드
+QNetworkInformation *networkInformation()
+{
+    static bool loaded = QNetworkInformation::loadBackendByFeatures(QNetworkInformation::Feature::Reachability);
+    return loaded ? QNetworkInformation::instance() : nullptr;
+}
+}
+
+ReconnectScheduler::ReconnectScheduler(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_armed(false)
+    , m_exhausted(false)
+    , m_attempts(0)
+    , m_initialDelayMs(500)
+    , m_maxDelayMs(30000)
+    , m_multiplier(2.0)
+    , m_jitterRatio(0.2)
+    , m_maxAttempts(10)
+    , m_neverGiveUp(false)
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &ReconnectScheduler::onTimeout);
+
+    if (QNetworkInformation *info = networkInformation()) {
+        connect(info, &QNetworkInformation::reachabilityChanged,
+                this, &ReconnectScheduler::onReachabilityChanged);
+    } else {
+        qDebug() << "[Reconnect] QNetworkInformation 백엔드 없음 - 백오프 타이머만 사용";
+    }
+}
+
+void ReconnectScheduler::schedule()
+{
+    m_armed = true;
+
+    if (m_timer->isActive() || m_exhausted) {
+        return;
+    }
+
+    if (!m_neverGiveUp && m_maxAttempts > 0 && m_attempts >= m_maxAttempts) {
+        qDebug() << "[Reconnect] 최대 재연결 시도 횟수 도달:" << m_attempts;
+        m_exhausted = true;
+        emit gaveUp();
+        return;
+    }
+
+    const int delayMs = nextDelayMs();
+    qDebug() << "[Reconnect] 재연결 예약 - 시도" << (m_attempts + 1) << "," << delayMs << "ms 후";
+    emit reconnectScheduled(m_attempts + 1, delayMs);
+    m_timer->start(delayMs);
+}
+
+void ReconnectScheduler::reset()
+{
+    m_timer->stop();
+    m_armed = false;
+    m_exhausted = false;
+    m_attempts = 0;
+}
+
+void ReconnectScheduler::cancel()
+{
+    reset();
+}
+
+void ReconnectScheduler::retryNow()
+{
+    m_timer->stop();
+    m_armed = true;
+    m_exhausted = false;
+    m_attempts = 0;
+    fire();
+}
+
+bool ReconnectScheduler::isPending() const
+{
+    return m_timer->isActive();
+}
+
+int ReconnectScheduler::nextDelayMs() const
+{
+    // initial * multiplier^attempts, 상한 적용
+    const double base = qMin(static_cast<double>(m_maxDelayMs),
+                             m_initialDelayMs * qPow(m_multiplier, m_attempts));
+
+    // ±jitter 비율만큼 무작위로 흔들어 여러 클라이언트가 동시에 몰리지 않게 함
+    const double jitter = base * m_jitterRatio;
+    const double offset = (QRandomGenerator::global()->generateDouble() * 2.0 - 1.0) * jitter;
+    return qMax(0, static_cast<int>(base + offset));
+}
+
+bool ReconnectScheduler::isNetworkDown() const
+{
+    QNetworkInformation *info = networkInformation();
+    return info && info->reachability() == QNetworkInformation::Reachability::Disconnected;
+}
+
+void ReconnectScheduler::onTimeout()
+{
+    // 네트워크가 확실히 끊겨 있으면 시도 횟수를 소모하지 않고 복구 알림을 기다린다
+    if (isNetworkDown()) {
+        qDebug() << "[Reconnect] 네트워크 끊김 - 복구 대기";
+        return;
+    }
+    fire();
+}
+
+void ReconnectScheduler::fire()
+{
+    m_attempts++;
+    qDebug() << "[Reconnect] 재연결 시도" << m_attempts
+             << (m_neverGiveUp ? QString("(무제한)") : QString("/ %1").arg(m_maxAttempts));
+    emit reconnectRequested(m_attempts);
+}
+
+void ReconnectScheduler::onReachabilityChanged(QNetworkInformation::Reachability reachability)
+{
+    qDebug() << "[Reconnect] 네트워크 상태 변경:" << reachability;
+
+    if (!m_armed || reachability == QNetworkInformation::Reachability::Disconnected) {
+        return;
+    }
+
+    // 네트워크가 돌아왔으면 백오프를 처음부터 다시 시작하고 즉시 재시도
+    m_timer->stop();
+    m_exhausted = false;
+    m_attempts = 0;
+    fire();
+}
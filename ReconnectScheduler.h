@@ -0,0 +1,69 @@
+#ifndef RECONNECTSCHEDULER_H
+#define RECONNECTSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QNetworkInformation>
+
+// 재연결 스케줄러 (TcpCommunicator, VideoStreamWidget 공용)
+// - 지수 백오프 + 지터 + 최대 지연 상한
+// - QNetworkInformation 이 네트워크 복구를 알리면 대기 없이 즉시 재시도
+// - neverGiveUp 이면 최대 시도 횟수 없이 계속 재시도 (무인 관제용)
+class ReconnectScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReconnectScheduler(QObject *parent = nullptr);
+
+    // 연결이 끊겼을 때 호출 - 다음 시도를 예약 (이미 예약되어 있으면 무시)
+    void schedule();
+    // 연결에 성공했을 때 호출 - 백오프 초기화
+    void reset();
+    // 사용자가 연결을 끊었을 때 호출 - 예약 취소, 네트워크 복구 시에도 재시도하지 않음
+    void cancel();
+    // 사용자가 바로 다시 시도할 때 호출 - 백오프를 처음부터 다시 시작하고 대기 없이 재시도
+    void retryNow();
+
+    bool isPending() const;
+    int attempts() const { return m_attempts; }
+
+    void setInitialDelay(int ms) { m_initialDelayMs = ms; }
+    void setMaxDelay(int ms) { m_maxDelayMs = ms; }
+    void setMultiplier(double multiplier) { m_multiplier = multiplier; }
+    void setJitter(double ratio) { m_jitterRatio = ratio; }
+    void setMaxAttempts(int attempts) { m_maxAttempts = attempts; }
+    void setNeverGiveUp(bool enabled) { m_neverGiveUp = enabled; }
+
+    int maxAttempts() const { return m_maxAttempts; }
+    bool neverGiveUp() const { return m_neverGiveUp; }
+
+signals:
+    // 소유자가 실제 재연결을 수행해야 하는 시점
+    void reconnectRequested(int attempt);
+    void reconnectScheduled(int attempt, int delayMs);
+    void gaveUp();
+
+private slots:
+    void onTimeout();
+    void onReachabilityChanged(QNetworkInformation::Reachability reachability);
+
+private:
+    int nextDelayMs() const;
+    bool isNetworkDown() const;
+    void fire();
+
+    QTimer *m_timer;
+    bool m_armed;               // 연결이 끊겨 복구를 기다리는 중
+    bool m_exhausted;           // 최대 시도 횟수 도달 (네트워크 복구 시에만 재개)
+    int m_attempts;
+
+    int m_initialDelayMs;
+    int m_maxDelayMs;
+    double m_multiplier;
+    double m_jitterRatio;
+    int m_maxAttempts;
+    bool m_neverGiveUp;
+};
+
+#endif // RECONNECTSCHEDULER_H
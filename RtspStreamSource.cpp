@@ -0,0 +1,266 @@
+#include "RtspStreamSource.h"
+#include "ClockSync.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHash>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 10, 0)
+#include <QPlaybackOptions>
+#endif
+
+namespace {
+QHash<QString, RtspStreamSource *> &sources()
+{
+    static QHash<QString, RtspStreamSource *> registry;
+    return registry;
+}
+
+const qint64 kResyncThresholdMs = 10000;    // PTS 가 이만큼 튀면 (재연결, 절대 RTP 시각 등) 기준을 다시 잡음
+const qint64 kDelayEmitIntervalMs = 500;
+const qreal kFastCatchUpRate = 2.0;         // 최대 지연을 넘었을 때
+}
+
+RtspStreamSource *RtspStreamSource::forUrl(const QString &rtspUrl)
+{
+    const QUrl url(rtspUrl);
+    RtspStreamSource *&source = sources()[url.toString()];
+    if (!source) {
+        source = new RtspStreamSource(url, QCoreApplication::instance());
+    }
+    return source;
+}
+
+RtspStreamSource::Transport RtspStreamSource::transportFromName(const QString &name)
+{
+    const QString lower = name.trimmed().toLower();
+    if (lower == "tcp") {
+        return Transport::Tcp;
+    }
+    if (lower == "udp") {
+        return Transport::Udp;
+    }
+    return Transport::Auto;
+}
+
+RtspStreamSource::RtspStreamSource(const QUrl &url, QObject *parent)
+    : QObject(parent)
+    , m_url(url)
+    , m_player(new QMediaPlayer(this))
+    , m_decoderSink(new QVideoSink(this))
+    , m_playAnchorMs(-1)
+    , m_baselineMs(-1)
+    , m_delayMs(-1)
+    , m_lastDelayEmitMs(0)
+    , m_droppedFrames(0)
+    , m_catchUpRate(1.0)
+{
+    // CCTV 는 오디오가 필요 없으므로 QAudioOutput 을 만들지 않고, 오디오 트랙도 꺼서 디코드하지 않음
+    m_player->setVideoSink(m_decoderSink);
+    connect(m_player, &QMediaPlayer::tracksChanged, this, [this]() {
+        if (!m_player->audioTracks().isEmpty() && m_player->activeAudioTrack() != -1) {
+            qDebug() << "[RTSP] 오디오 트랙 끔:" << m_url.toString();
+            m_player->setActiveAudioTrack(-1);
+        }
+    });
+    connect(m_decoderSink, &QVideoSink::videoFrameChanged, this, &RtspStreamSource::onVideoFrameChanged);
+}
+
+RtspStreamSource::~RtspStreamSource()
+{
+    sources().remove(m_url.toString());
+    m_player->stop();
+}
+
+void RtspStreamSource::attach(QVideoSink *sink)
+{
+    if (!sink || m_sinks.contains(sink)) {
+        return;
+    }
+
+    m_sinks.append(sink);
+    // 화면이 먼저 사라져도 목록에 남지 않도록
+    connect(sink, &QObject::destroyed, this, [this, sink]() {
+        detach(sink);
+    });
+    qDebug() << "[RTSP] 화면 연결:" << m_url.toString() << "- 화면 수:" << m_sinks.size();
+
+    if (m_sinks.size() == 1) {
+        start();
+    } else if (m_lastFrame.isValid()) {
+        sink->setVideoFrame(m_lastFrame);
+    }
+}
+
+void RtspStreamSource::detach(QVideoSink *sink)
+{
+    const int index = m_sinks.indexOf(sink);
+    if (index < 0) {
+        return;
+    }
+
+    m_sinks.removeAt(index);
+    disconnect(sink, &QObject::destroyed, this, nullptr);
+    qDebug() << "[RTSP] 화면 해제:" << m_url.toString() << "- 화면 수:" << m_sinks.size();
+
+    if (m_sinks.isEmpty()) {
+        stop();
+    }
+}
+
+void RtspStreamSource::restart()
+{
+    if (m_sinks.isEmpty()) {
+        return;
+    }
+    m_player->stop();
+    start();
+}
+
+void RtspStreamSource::setLiveOptions(const LiveOptions &options)
+{
+    const bool reopen = !m_sinks.isEmpty() &&
+                        (options.transport != m_options.transport || options.lowLatency != m_options.lowLatency);
+    m_options = options;
+    if (!m_options.lowLatency) {
+        setCatchUpRate(1.0);
+    }
+    if (reopen) {
+        qDebug() << "[RTSP] 재생 옵션 변경 - 세션 다시 열기:" << m_url.toString();
+        restart();
+    }
+}
+
+QUrl RtspStreamSource::sessionUrl() const
+{
+    if (m_options.transport == Transport::Auto) {
+        return m_url;
+    }
+
+    // FFmpeg RTSP 디먹서는 주소 끝의 ?tcp / ?udp 를 전송 방식 옵션으로 읽고, 서버에 보내는 주소에서는 뺀다
+    const QString option = m_options.transport == Transport::Tcp ? "tcp" : "udp";
+    QUrl url(m_url);
+    url.setQuery(url.hasQuery() ? url.query() + '&' + option : option);
+    return url;
+}
+
+void RtspStreamSource::applyPlaybackOptions()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 10, 0)
+    // 디먹서/디코더 버퍼링을 최소로 (FFmpeg nobuffer, low_delay 등)
+    QPlaybackOptions options;
+    if (m_options.lowLatency) {
+        options.setPlaybackIntent(QPlaybackOptions::PlaybackIntent::LowLatencyStreaming);
+    }
+    m_player->setPlaybackOptions(options);
+#endif
+    setCatchUpRate(1.0);
+}
+
+void RtspStreamSource::start()
+{
+    qDebug() << "[RTSP] 세션 시작:" << sessionUrl().toString() << (m_options.lowLatency ? "(저지연)" : "");
+    applyPlaybackOptions();
+    m_player->setSource(sessionUrl());
+
+    // 지연 기준은 첫 디코드 프레임에서 잡음 (셋업/프로빙 시간을 늦은 프레임으로 세지 않도록)
+    m_baselineMs = -1;
+    m_delayMs = -1;
+    m_droppedFrames = 0;
+    // 캡처 시각은 PLAY 기준 - PTS 0 은 PLAY 직후 받은 첫 프레임
+    m_playAnchorMs = ClockSync::monotonicMs();
+    m_player->play();
+}
+
+void RtspStreamSource::stop()
+{
+    qDebug() << "[RTSP] 세션 종료:" << m_url.toString();
+    m_player->stop();
+    m_lastFrame = QVideoFrame();
+    m_playAnchorMs = -1;
+    m_baselineMs = -1;
+    m_delayMs = -1;
+    setCatchUpRate(1.0);
+}
+
+void RtspStreamSource::setCatchUpRate(qreal rate)
+{
+    if (qFuzzyCompare(m_catchUpRate, rate)) {
+        return;
+    }
+    qDebug() << "[RTSP] 재생 속도:" << rate << "- 지연:" << m_delayMs << "ms";
+    m_catchUpRate = rate;
+    m_player->setPlaybackRate(rate);
+}
+
+bool RtspStreamSource::updatePlaybackDelay(const QVideoFrame &frame)
+{
+    if (frame.startTime() < 0) {
+        return true;
+    }
+
+    const qint64 nowMs = ClockSync::monotonicMs();
+    const qint64 offsetMs = nowMs - frame.startTime() / 1000;
+    if (m_baselineMs < 0 || offsetMs - m_baselineMs > kResyncThresholdMs || m_baselineMs - offsetMs > kResyncThresholdMs) {
+        // 세션의 첫 프레임이거나 PTS 가 튐 (재연결, 절대 RTP 시각 등) - 이 프레임을 기준으로 다시 잡음
+        if (m_baselineMs >= 0) {
+            qDebug() << "[RTSP] 재생 지연 기준 재설정 - 차이:" << offsetMs - m_baselineMs << "ms";
+            // 캡처 시각 기준도 PTS 가 튄 만큼 같이 옮김 (PLAY 와 첫 프레임 사이 간격은 그대로)
+            if (m_playAnchorMs >= 0) {
+                m_playAnchorMs += offsetMs - m_baselineMs;
+            }
+        }
+        m_baselineMs = offsetMs;
+        m_delayMs = -1;
+    } else if (offsetMs < m_baselineMs) {
+        // 지금까지보다 빨리 나온 프레임 - 기준을 당김
+        m_baselineMs = offsetMs;
+    }
+    // PTS 가 0 부터 시작하지 않는 스트림이면 PLAY 기준이 디코드 시각보다 늦어짐 - 기준으로 자름
+    if (m_playAnchorMs > m_baselineMs) {
+        m_playAnchorMs = m_baselineMs;
+    }
+
+    const qint64 delayMs = offsetMs - m_baselineMs;
+    m_delayMs = m_delayMs < 0 ? delayMs : (7 * m_delayMs + delayMs) / 8;
+
+    bool keep = true;
+    if (m_options.lowLatency) {
+        if (delayMs > m_options.maxDelayMs) {
+            // 너무 늦은 프레임은 보여 줘도 경고 시점을 놓침 - 버리고 빠르게 따라잡음
+            keep = false;
+            m_droppedFrames++;
+            setCatchUpRate(kFastCatchUpRate);
+        } else if (m_delayMs > m_options.targetDelayMs) {
+            setCatchUpRate(m_options.catchUpPercent / 100.0);
+        } else if (m_delayMs < m_options.targetDelayMs * 3 / 4) {
+            setCatchUpRate(1.0);
+        }
+    }
+
+    if (nowMs - m_lastDelayEmitMs >= kDelayEmitIntervalMs) {
+        m_lastDelayEmitMs = nowMs;
+        emit playbackDelayChanged(m_delayMs, m_droppedFrames);
+    }
+    return keep;
+}
+
+qint64 RtspStreamSource::captureTimeMs(qint64 startTimeUs) const
+{
+    if (startTimeUs < 0 || m_playAnchorMs < 0) {
+        return -1;
+    }
+    return m_playAnchorMs + startTimeUs / 1000;
+}
+
+void RtspStreamSource::onVideoFrameChanged(const QVideoFrame &frame)
+{
+    if (!updatePlaybackDelay(frame) && m_lastFrame.isValid()) {
+        return;
+    }
+
+    // QVideoFrame 은 암시적 공유 - 화면마다 복사되지 않는다
+    m_lastFrame = frame;
+    for (QVideoSink *sink : std::as_const(m_sinks)) {
+        sink->setVideoFrame(frame);
+    }
+    emit videoFrameChanged(frame);
+}
@@ -0,0 +1,103 @@
+#ifndef RTSPSTREAMSOURCE_H
+#define RTSPSTREAMSOURCE_H
+
+#include <QObject>
+#include <QList>
+#include <QMediaPlayer>
+#include <QUrl>
+#include <QVideoFrame>
+#include <QVideoSink>
+
+// RTSP 주소 하나당 세션/디코더 하나를 여러 화면이 같이 쓰도록 나눠 주는 소스
+// 디코드된 프레임을 내부 QVideoSink 로 받아 붙어 있는 모든 싱크(QVideoWidget, QGraphicsVideoItem)로 보낸다.
+// 붙은 싱크 수로 참조를 세어 마지막 화면이 떨어지면 재생을 멈추고 카메라 세션을 놓는다.
+//
+// 저지연 모드에서는 쌓인 재생 지연을 프레임마다 추정해
+//   목표 지연을 넘으면 재생 속도를 조금 올려 쌓인 버퍼를 비우고 (catch-up),
+//   최대 지연을 넘은 프레임은 화면에 보내지 않고 버린다.
+// 쌓인 재생 지연 = (지금 - PTS) - 기준, 기준은 지금까지 본 (지금 - PTS) 의 최솟값 (가장 빨리 나온 프레임).
+// RTSP 셋업/프로빙 시간은 모든 프레임에 같이 들어가므로 기준에 흡수되어 늦은 프레임으로 세지 않는다.
+//
+// 프레임의 캡처 시각은 PLAY 기준으로 추정한다: PTS 0 은 PLAY 직후 카메라가 보낸 첫 프레임이므로
+//   캡처 시각 = 세션 시작 시각 + PTS. 디코드/재생 버퍼링 시간은 빠지고, 셋업 시간만큼 이르게 나올 수 있다.
+// 디코더에서 나온 시각보다 늦을 수는 없으므로 기준((지금 - PTS) 최솟값)을 넘지 않게 자른다.
+class RtspStreamSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Transport {
+        Auto,       // FFmpeg 기본 (UDP 시도 후 TCP)
+        Tcp,        // RTP over RTSP (interleaved) - 손실 없음, 방화벽 통과
+        Udp         // 손실 시 프레임이 깨질 수 있지만 재전송 지연이 없음
+    };
+
+    struct LiveOptions {
+        bool lowLatency = false;
+        Transport transport = Transport::Auto;
+        int targetDelayMs = 150;        // 이보다 늦으면 catch-up
+        int maxDelayMs = 600;           // 이보다 늦은 프레임은 버림
+        int catchUpPercent = 110;       // catch-up 재생 속도 (%)
+    };
+
+    static Transport transportFromName(const QString &name);
+
+    // 같은 주소면 같은 소스 (앱 종료 시 함께 해제)
+    static RtspStreamSource *forUrl(const QString &rtspUrl);
+
+    ~RtspStreamSource();
+
+    // 첫 싱크가 붙으면 재생 시작, 이미 재생 중이면 마지막 프레임을 바로 넘겨 줌
+    void attach(QVideoSink *sink);
+    void detach(QVideoSink *sink);
+    int viewerCount() const { return m_sinks.size(); }
+
+    // 재연결: 세션을 닫고 다시 연다 (붙어 있는 화면은 그대로)
+    void restart();
+
+    QMediaPlayer *player() const { return m_player; }
+    const QUrl &url() const { return m_url; }
+
+    // 세션 하나를 같이 쓰므로 마지막으로 설정한 값이 모든 화면에 적용됨
+    // 전송 방식이나 저지연 여부가 바뀌면 재생 중인 세션을 다시 연다.
+    void setLiveOptions(const LiveOptions &options);
+    const LiveOptions &liveOptions() const { return m_options; }
+
+    qint64 playbackDelayMs() const { return m_delayMs; }     // 쌓인 재생 지연 (측정 전 -1)
+    // 프레임 PTS(QVideoFrame::startTime, us) 의 캡처 시각 추정 (ClockSync::monotonicMs 기준, 모르면 -1)
+    qint64 captureTimeMs(qint64 startTimeUs) const;
+    int droppedFrames() const { return m_droppedFrames; }
+
+signals:
+    void videoFrameChanged(const QVideoFrame &frame);
+    // 평활한 재생 지연 (최대 초당 두 번)
+    void playbackDelayChanged(qint64 delayMs, int droppedFrames);
+
+private:
+    explicit RtspStreamSource(const QUrl &url, QObject *parent = nullptr);
+
+    void onVideoFrameChanged(const QVideoFrame &frame);
+    void start();
+    void stop();
+    QUrl sessionUrl() const;
+    void applyPlaybackOptions();
+    // 프레임의 재생 지연을 갱신하고 버릴 프레임이면 false
+    bool updatePlaybackDelay(const QVideoFrame &frame);
+    void setCatchUpRate(qreal rate);
+
+    QUrl m_url;
+    QMediaPlayer *m_player;
+    QVideoSink *m_decoderSink;          // 플레이어 출력 (한 번만 디코드)
+    QList<QVideoSink *> m_sinks;        // 싱크가 파괴되면 destroyed 에서 빠짐
+    QVideoFrame m_lastFrame;
+
+    LiveOptions m_options;
+    qint64 m_playAnchorMs;          // PTS 0 프레임의 캡처 시각 추정 (PLAY 기준, -1 이면 모름)
+    qint64 m_baselineMs;            // (로컬 단조 시각 - PTS) 의 최솟값 (-1 이면 첫 프레임에서 잡음)
+    qint64 m_delayMs;               // 기준을 넘는 지연의 평활값
+    qint64 m_lastDelayEmitMs;
+    int m_droppedFrames;
+    qreal m_catchUpRate;            // 1.0 이면 catch-up 안 함
+};
+
+#endif // RTSPSTREAMSOURCE_H
@@ -1,4 +1,10 @@
 #include "TcpCommunicator.h"
+#include "TcpIoWorker.h"
+#include "ReconnectScheduler.h"
+#include "FrameDecoder.h"
+#include "PendingRequest.h"
+#include "PayloadCodec.h"
+#include "CaptureCache.h"
 #include <QDebug>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -6,60 +12,80 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFileInfo>
+#include <QtEndian>
+#include <cstring>
+#include <algorithm>
+#include <utility>
 
 #include "LineDrawingDialog.h"
 
 TcpCommunicator::TcpCommunicator(QObject *parent)
     : QObject(parent)
-    , m_socket(new QSslSocket(this))
-    , m_connectionTimer(nullptr)
-    , m_reconnectTimer(new QTimer(this))
+    , m_ioThread(nullptr)
+    , m_ioWorker(nullptr)
+    , m_reconnectScheduler(new ReconnectScheduler(this))
     , m_host("")
     , m_port(0)
     , m_isConnected(false)
+    , m_manualDisconnect(false)
+    , m_connectionState(ConnectionState::Disconnected)
+    , m_outboundFrames(0)
+    , m_flushScheduled(false)
+    , m_writeHighWaterMark(4 * 1024 * 1024)    // 4MB
+    , m_writeBackpressured(false)
+    , m_pendingRequests(new PendingRequestTable(this))
+    , m_captureCache(new CaptureCache(this))
+    , m_payloadEncoding(PayloadCodec::Encoding::Json)
+    , m_cborRequested(false)
+    , m_clockSyncTimer(new QTimer(this))
+    , m_clockSyncIntervalMs(0)
+    , m_clockSyncBurstRemaining(0)
+    , m_clockSyncFailures(0)
+    , m_clockPingInFlight(false)
+    , m_bboxLatencyMs(-1)
     , m_receivedData("")
     , m_videoView(nullptr)
 
+    , m_resolveTimeoutMs(5000)
     , m_connectionTimeoutMs(10000)
+    , m_handshakeTimeoutMs(10000)
     , m_reconnectEnabled(true)
-    , m_reconnectAttempts(0)
-    , m_maxReconnectAttempts(5)
-    , m_reconnectDelayMs(3000)
     , m_autoReconnect(true)
 
     , m_roadLinesReceived(false)
     , m_detectionLinesReceived(false)
 {
     qDebug() << "[TCP] TcpCommunicator 생성자 호출";
-    m_socket = new QSslSocket(this);
-    setupSslConfiguration();
-
-    // Keep-Alive settings
-    m_socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
-    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
-
-    // TCP 소켓 시그널 연결
-    connect(m_socket, &QSslSocket::connected, this, &TcpCommunicator::onConnected);
-    connect(m_socket, &QSslSocket::disconnected, this, &TcpCommunicator::onDisconnected);
-    connect(m_socket, &QSslSocket::readyRead, this, &TcpCommunicator::onReadyRead);
-    connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QSslSocket::errorOccurred),
-            this, &TcpCommunicator::onSocketError);
-
-    // Connect SSL signals
-    connect(m_socket, &QSslSocket::encrypted, this, &TcpCommunicator::onSslEncrypted);
-    connect(m_socket, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
-            this, &TcpCommunicator::onSslErrors);
-
-    // Connection timeout timer
-    m_connectionTimer = new QTimer(this);
-    m_connectionTimer->setSingleShot(true);
-    m_connectionTimer->setInterval(m_connectionTimeoutMs);
-    connect(m_connectionTimer, &QTimer::timeout, this, &TcpCommunicator::onConnectionTimeout);
-
-    // 재연결 타이머 설정
-    m_reconnectTimer->setSingleShot(true);
-    m_reconnectTimer->setInterval(m_reconnectDelayMs);
-    connect(m_reconnectTimer, &QTimer::timeout, this, &TcpCommunicator::onReconnectTimer);
+
+    // 소켓 I/O, TLS, 프레이밍, JSON 파싱은 전용 스레드에서 수행
+    m_ioThread = new QThread(this);
+    m_ioThread->setObjectName("TcpIoThread");
+    m_ioWorker = new TcpIoWorker();
+    m_ioWorker->moveToThread(m_ioThread);
+    connect(m_ioThread, &QThread::started, m_ioWorker, &TcpIoWorker::initialize);
+    connect(m_ioThread, &QThread::finished, m_ioWorker, &QObject::deleteLater);
+
+    // I/O 스레드 시그널 연결 (queued)
+    // 연결 단계와 단계별 타임아웃은 I/O 스레드의 상태 머신이 관리한다
+    connect(m_ioWorker, &TcpIoWorker::connectionStateChanged, this, &TcpCommunicator::onConnectionStateChanged);
+    connect(m_ioWorker, &TcpIoWorker::stageTimedOut, this, &TcpCommunicator::onStageTimedOut);
+    connect(m_ioWorker, &TcpIoWorker::handshakeCompleted, this, &TcpCommunicator::onHandshakeCompleted);
+    connect(m_ioWorker, &TcpIoWorker::writeDrained, this, &TcpCommunicator::onWriteDrained);
+    connect(m_pendingRequests, &PendingRequestTable::requestAbandoned, this, &TcpCommunicator::onRequestAbandoned);
+    connect(m_ioWorker, &TcpIoWorker::socketErrorOccurred, this, &TcpCommunicator::onSocketError);
+    connect(m_ioWorker, &TcpIoWorker::messagesAvailable, this, &TcpCommunicator::onInboundMessages);
+
+    m_ioThread->start();
+    applyStageTimeouts();
+
+    // 재연결 스케줄러 (지수 백오프 + 네트워크 복구 시 즉시 재시도)
+    connect(m_reconnectScheduler, &ReconnectScheduler::reconnectRequested,
+            this, &TcpCommunicator::onReconnectRequested);
+    connect(m_reconnectScheduler, &ReconnectScheduler::gaveUp,
+            this, &TcpCommunicator::onReconnectGaveUp);
+
+    m_clockSyncTimer->setSingleShot(true);
+    connect(m_clockSyncTimer, &QTimer::timeout, this, &TcpCommunicator::sendClockPing);
 
     qDebug() << "[TCP] TcpCommunicator 초기화 완료";
 }
@@ -67,47 +93,34 @@ TcpCommunicator::TcpCommunicator(QObject *parent)
 TcpCommunicator::~TcpCommunicator()
 {
     disconnectFromServer();
-}
-
-void TcpCommunicator::disconnectFromServer()
-{
-    if (m_connectionTimer->isActive()) {
-        m_connectionTimer->stop();
-    }
-    if (m_reconnectTimer->isActive()) {
-        m_reconnectTimer->stop();
-    }
 
-    if (m_socket && m_socket->state() != QAbstractSocket::UnconnectedState) {
-        m_socket->disconnectFromHost();
-        if (m_socket->state() != QAbstractSocket::UnconnectedState) {
-            m_socket->waitForDisconnected(3000);
-        }
+    // I/O 스레드 정리: 큐 대기를 풀고 소켓을 닫은 뒤 스레드 종료
+    m_ioWorker->stop();
+    if (m_ioThread->isRunning()) {
+        QMetaObject::invokeMethod(m_ioWorker, &TcpIoWorker::shutdown, Qt::BlockingQueuedConnection);
+        m_ioThread->quit();
+        m_ioThread->wait();
     }
 }
 
-void TcpCommunicator::setupSslConfiguration() {
-    // Register server's CA certificate (e.g., ca-cert.pem file)
-    QSslConfiguration sslConfiguration = QSslConfiguration::defaultConfiguration();
-
-    // 2. Load server's CA certificate
-    QList<QSslCertificate> caCerts = QSslCertificate::fromPath(":/ca-cert.crt");
-    if (!caCerts.isEmpty()) {
-        qDebug() << "[TCP] CA certificates loaded:" << caCerts.size() << "items";
-        // 3. Add loaded CA certificates to SSL configuration
-        sslConfiguration.setCaCertificates(caCerts);
-    } else {
-        qDebug() << "[TCP] Warning: ca-cert.crt file not found or could not be read.";
-        qDebug() << "[TCP] SSL 인증서 검증을 완화하여 연결을 시도합니다.";
-    }
+QString TcpCommunicator::connectionStateToString(ConnectionState state)
+{
+    switch (state) {
+    case ConnectionState::Disconnected: return "Disconnected";
+    case ConnectionState::Resolving:    return "Resolving";
+    case ConnectionState::Connecting:   return "Connecting";
+    case ConnectionState::Handshaking:  return "Handshaking";
+    case ConnectionState::Ready:        return "Ready";
+    }
+    return "Unknown";
+}
 
-    // 4. Apply SSL configuration to the socket
-    m_socket->setSslConfiguration(sslConfiguration);
+void TcpCommunicator::disconnectFromServer()
+{
+    m_manualDisconnect = true;
+    stopReconnectTimer();
 
-    // 5. Set server certificate verification mode
-    // 개발 환경에서는 VerifyNone으로 설정하여 연결 문제 해결
-    m_socket->setPeerVerifyMode(QSslSocket::VerifyNone);
-    qDebug() << "[TCP] SSL Peer verification mode set to VerifyNone for development";
+    QMetaObject::invokeMethod(m_ioWorker, &TcpIoWorker::disconnectFromHost, Qt::QueuedConnection);
 }
 
 void TcpCommunicator::connectToServer(const QString &host, quint16 port)
@@ -116,33 +129,21 @@ void TcpCommunicator::connectToServer(const QString &host, quint16 port)
 
     m_host = host;
     m_port = port;
+    m_isConnected = false;
+    m_manualDisconnect = false;
 
-    // 이미 연결되어 있으면 연결 해제 후 재연결
-    if (m_socket->state() != QSslSocket::UnconnectedState) {
-        qDebug() << "[TCP] 기존 연결 해제 중... 현재 상태:" << m_socket->state();
-        m_socket->disconnectFromHost();
-        if (m_socket->state() != QSslSocket::UnconnectedState) {
-            m_socket->waitForDisconnected(1000);
-        }
-    }
-
-    qDebug() << "[TCP] 서버 연결 시도:" << host << ":" << port;
-    qDebug() << "[TCP] SSL 설정 확인 - Peer Verify Mode:" << m_socket->peerVerifyMode();
-    
-    m_socket->connectToHostEncrypted(m_host, static_cast<qint16>(m_port));
-
-    // 연결 타임아웃 설정 (10초)
-    if (!m_socket->waitForConnected(10000)) {
-        qDebug() << "[TCP] 연결 타임아웃 또는 실패:" << m_socket->errorString();
-        emit errorOccurred("연결 타임아웃: " + m_socket->errorString());
-    } else {
-        qDebug() << "[TCP] TCP 연결 성공, SSL 핸드셰이크 대기 중...";
-    }
+    // 연결 시도는 I/O 스레드에서 비동기로 진행 (GUI 스레드는 블로킹되지 않음)
+    startConnection();
 }
 
 bool TcpCommunicator::isConnectedToServer() const
 {
-    return m_isConnected && m_socket && m_socket->state() == QAbstractSocket::ConnectedState;
+    return m_isConnected;
+}
+
+TcpCommunicator::ConnectionState TcpCommunicator::connectionState() const
+{
+    return m_connectionState;
 }
 
 bool TcpCommunicator::sendJsonMessage(const QJsonObject &message)
@@ -152,36 +153,99 @@ bool TcpCommunicator::sendJsonMessage(const QJsonObject &message)
         return false;
     }
 
-    QJsonDocument doc(message);
-    QByteArray data = doc.toJson(QJsonDocument::Compact);
+    // 협상이 끝나기 전까지는 JSON, 서버가 수락하면 정수 키 CBOR
+    const QByteArray payload = PayloadCodec::encode(message, m_payloadEncoding);
+    const qsizetype frameSize = FrameDecoder::HeaderSize + payload.size();
 
-    // qDebug() << "[TCP] JSON 메시지 전송 시도:" << data;
-
-    // 1. 데이터 길이(4바이트, 빅엔디안) 전송
-    quint32 dataLength = static_cast<quint32>(data.size());
-    QByteArray lengthBytes;
-    QDataStream lengthStream(&lengthBytes, QIODevice::WriteOnly);
-    lengthStream.setByteOrder(QDataStream::BigEndian);
-    lengthStream << dataLength;
-    
-    // 2. 길이 + 데이터 순서로 전송
-    qint64 bytesWritten = m_socket->write(lengthBytes);
-    if (bytesWritten != 4) {
-        qDebug() << "[TCP] 길이 정보 전송 실패:" << m_socket->errorString();
+    // 송신 대기량이 high-water mark 를 넘으면 버퍼를 더 키우지 않고 호출자에게 알린다
+    const qint64 pending = pendingWriteBytes();
+    if (pending > 0 && pending + frameSize > m_writeHighWaterMark) {
+        qDebug() << "[TCP] 송신 버퍼 포화 - 대기 바이트:" << pending << "한도:" << m_writeHighWaterMark;
+        if (!m_writeBackpressured) {
+            m_writeBackpressured = true;
+            m_ioWorker->requestDrainNotification(m_writeHighWaterMark / 2);
+            emit writeBackpressureChanged(true);
+        }
         return false;
     }
-    bytesWritten = m_socket->write(data);
-    bool flushed = m_socket->flush();
 
-    if (bytesWritten == -1) {
-        qDebug() << "[TCP] 메시지 전송 실패:" << m_socket->errorString();
-        return false;
+    // 길이(4바이트, 빅엔디안) + 페이로드를 송신 버퍼에 바로 이어 붙임
+    const qsizetype offset = m_outbound.size();
+    m_outbound.resize(offset + frameSize);
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), m_outbound.data() + offset);
+    std::memcpy(m_outbound.data() + offset + FrameDecoder::HeaderSize, payload.constData(),
+                static_cast<size_t>(payload.size()));
+    m_outboundFrames++;
+
+    // 현재 이벤트 처리가 끝난 뒤 한 번에 I/O 스레드로 넘김
+    if (!m_flushScheduled) {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(this, &TcpCommunicator::flushOutbound, Qt::QueuedConnection);
     }
 
-    qDebug() << "[TCP] 메시지 전송 성공 - 바이트:" << bytesWritten << "플러시:" << flushed;
     return true;
 }
 
+PendingRequest *TcpCommunicator::sendRequest(QJsonObject message, int responseId, int timeoutMs)
+{
+    PendingRequest *request = m_pendingRequests->add(message["request_id"].toInt(), responseId, timeoutMs);
+    if (!transmitRequest(request, message)) {
+        m_pendingRequests->fail(request, "Failed to send request");
+        return nullptr;
+    }
+    return request;
+}
+
+bool TcpCommunicator::transmitRequest(PendingRequest *request, QJsonObject message)
+{
+    // 서버는 응답에 같은 seq 를 돌려준다
+    message["seq"] = static_cast<qint64>(request->seq());
+    request->m_sentUs = ClockSync::monotonicUs();
+    return sendJsonMessage(message);
+}
+
+void TcpCommunicator::onRequestAbandoned(quint32 seq)
+{
+    m_ioWorker->ignoreReply(seq);
+}
+
+void TcpCommunicator::flushOutbound()
+{
+    m_flushScheduled = false;
+    if (m_outbound.isEmpty()) {
+        return;
+    }
+
+    // 실제 쓰기는 소켓을 소유한 I/O 스레드에서 수행
+    m_ioWorker->submitWrite(m_outbound, m_outboundFrames);
+    m_outbound = QByteArray();
+    m_outboundFrames = 0;
+}
+
+qint64 TcpCommunicator::pendingWriteBytes() const
+{
+    return m_outbound.size() + m_ioWorker->pendingWriteBytes();
+}
+
+int TcpCommunicator::pendingRequestCount() const
+{
+    return m_pendingRequests->size();
+}
+
+void TcpCommunicator::setWriteHighWaterMark(qint64 bytes)
+{
+    m_writeHighWaterMark = bytes;
+}
+
+void TcpCommunicator::onWriteDrained()
+{
+    if (m_writeBackpressured) {
+        qDebug() << "[TCP] 송신 버퍼 여유 확보 - 전송 재개 가능";
+        m_writeBackpressured = false;
+        emit writeBackpressureChanged(false);
+    }
+}
+
 bool TcpCommunicator::sendMessage(const QString &message)
 {
     QJsonParseError error;
@@ -333,7 +397,7 @@ bool TcpCommunicator::requestSavedRoadLines()
     QJsonObject message;
     message["request_id"] = 7;  // 도로선 select all 요청
 
-    bool success = sendJsonMessage(message);
+    bool success = sendRequest(message, 16, DefaultRequestTimeoutMs) != nullptr;
     if (success) {
         qDebug() << "[TCP] 저장된 도로선 데이터 요청 성공 (request_id: 7)";
     } else {
@@ -356,7 +420,7 @@ bool TcpCommunicator::requestSavedDetectionLines()
     QJsonObject message;
     message["request_id"] = 3;  // 감지선 select all 요청
 
-    bool success = sendJsonMessage(message);
+    bool success = sendRequest(message, 12, DefaultRequestTimeoutMs) != nullptr;
     if (success) {
         qDebug() << "[TCP] 저장된 감지선 데이터 요청 전송 성공 (request_id: 3)";
     } else {
@@ -399,13 +463,13 @@ bool TcpCommunicator::sendMultipleRoadLines(const QList<RoadLineData> &roadLines
     bool allSuccess = true;
     int successCount = 0;
 
+    // 프레임은 송신 큐에서 한 번의 write 로 묶이므로 GUI 스레드를 재울 필요가 없다
     for (const auto &line : roadLines) {
         if (sendRoadLine(line)) {
             successCount++;
         } else {
             allSuccess = false;
         }
-        QThread::msleep(100);
     }
 
     qDebug() << "[TCP] Multiple road lines sending complete - Success:" << successCount
@@ -431,7 +495,6 @@ bool TcpCommunicator::sendMultipleDetectionLines(const QList<DetectionLineData>
         } else {
             allSuccess = false;
         }
-        QThread::msleep(50);
     }
 
     qDebug() << "[TCP] Multiple detection lines sending complete - Success:" << successCount
@@ -510,16 +573,38 @@ bool TcpCommunicator::sendCategorizedLineCoordinates(const QList<CategorizedLine
     return overallSuccess;
 }
 
-void TcpCommunicator::requestImageData(const QString &date, int hour)
+PendingRequest *TcpCommunicator::requestImageData(const QString &date, int hour, int timeoutMs)
+{
+    return requestImagePage(date, hour, QString(), 0, ImageDetail::Full, timeoutMs);
+}
+
+PendingRequest *TcpCommunicator::requestImagePage(const QString &date, int hour, const QString &afterTimestamp,
+                                                  int pageSize, ImageDetail detail, int timeoutMs)
+{
+    return sendImagePageRequest(date, hour, afterTimestamp, pageSize, detail, timeoutMs, false);
+}
+
+PendingRequest *TcpCommunicator::prefetchImagePage(const QString &date, int hour, const QString &afterTimestamp,
+                                                   int pageSize, ImageDetail detail, int timeoutMs)
+{
+    return sendImagePageRequest(date, hour, afterTimestamp, pageSize, detail, timeoutMs, true);
+}
+
+PendingRequest *TcpCommunicator::sendImagePageRequest(const QString &date, int hour, const QString &afterTimestamp,
+                                                      int pageSize, ImageDetail detail, int timeoutMs, bool quiet)
 {
     if (!isConnectedToServer()) {
         qDebug() << "[TCP] Failed to request image data, no connection.";
-        emit errorOccurred("Not connected to server");
-        return;
+        if (!quiet) {
+            emit errorOccurred("Not connected to server");
+        }
+        return nullptr;
     }
 
+    // 목록 조회는 원본 대신 메타데이터 + 썸네일만 (응답 41)
+    const bool listing = (detail == ImageDetail::Thumbnail);
     QJsonObject message;
-    message["request_id"] = 1;
+    message["request_id"] = listing ? 40 : 1;
 
     QJsonObject data;
     QString requestDate = date.isEmpty() ? QDate::currentDate().toString("yyyy-MM-dd") : date;
@@ -532,294 +617,731 @@ void TcpCommunicator::requestImageData(const QString &date, int hour)
         data["end_timestamp"] = requestDate + "T23";
     }
 
+    // 커서 페이지: afterTimestamp 보다 늦은 이미지를 시간순으로 최대 limit 개
+    if (!afterTimestamp.isEmpty()) {
+        data["after_timestamp"] = afterTimestamp;
+    }
+    if (pageSize > 0) {
+        data["limit"] = pageSize;
+    }
+    const QSize listingThumbnailSize(300, 200);
+    if (listing) {
+        data["thumbnail_size"] = QJsonArray{ listingThumbnailSize.width(), listingThumbnailSize.height() };
+    }
+
+    // 캐시에 있는 타임스탬프는 서버에 알려서 빠진 이미지만 받는다
+    // (이 필드를 모르는 서버는 전부 보내고, 겹치는 이미지는 deliverImage 에서 걸러짐)
+    const QString timestampPrefix = (hour >= 0 && hour <= 23)
+        ? QString("%1T%2").arg(requestDate).arg(hour, 2, 10, QChar('0'))
+        : requestDate;
+    // 커서 뒤의 캐시 항목은 모두 서버가 건너뛸 목록으로 보내고,
+    // 그중 이 페이지에 들어가는 것만 서버 응답을 받은 뒤 골라서 전달한다 (finishImagePage)
+    QList<CaptureCache::Entry> cached = m_captureCache->find(serverKey(), timestampPrefix);
+    if (!afterTimestamp.isEmpty()) {
+        cached.erase(std::remove_if(cached.begin(), cached.end(), [&afterTimestamp](const CaptureCache::Entry &entry) {
+            return entry.timestamp <= afterTimestamp;
+        }), cached.end());
+    }
+    std::sort(cached.begin(), cached.end(), [](const CaptureCache::Entry &a, const CaptureCache::Entry &b) {
+        return a.timestamp < b.timestamp;
+    });
+    if (!cached.isEmpty()) {
+        QJsonArray cachedTimestamps;
+        for (const CaptureCache::Entry &entry : cached) {
+            cachedTimestamps.append(entry.timestamp);
+        }
+        data["cached_timestamps"] = cachedTimestamps;
+    }
+
     message["data"] = data;
 
-    bool success = sendJsonMessage(message);
-    if (success) {
-        qDebug() << "[TCP] Image request sent - request_id: 1, Date:" << requestDate << "Hour:" << hour;
-        emit statusUpdated("Requesting images...");
+    PendingRequest *request = sendRequest(message, listing ? 41 : 10, timeoutMs);
+    if (request) {
+        qDebug() << "[TCP] Image request sent - request_id:" << message["request_id"].toInt() << "seq:" << request->seq()
+                 << "Date:" << requestDate << "Hour:" << hour << "Cached:" << cached.size()
+                 << "After:" << afterTimestamp << "Limit:" << pageSize << (quiet ? "(prefetch)" : "");
+        if (!quiet) {
+            emit statusUpdated("Requesting images...");
+        }
+
+        request->m_pageSize = pageSize;
+        request->m_quiet = quiet;
+        request->m_cachedCandidates = cached;
+        if (listing) {
+            request->m_cacheThumbnailSize = listingThumbnailSize;
+        }
     } else {
         qDebug() << "[TCP] Failed to request image data.";
-        emit errorOccurred("Failed to send image request");
+        if (!quiet) {
+            emit errorOccurred("Failed to send image request");
+        }
     }
+    return request;
 }
 
-void TcpCommunicator::setConnectionTimeout(int timeoutMs)
+void TcpCommunicator::finishImagePage(PendingRequest *request)
 {
-    m_connectionTimeoutMs = timeoutMs;
+    // 서버가 보낸 이미지와 캐시 후보를 합쳐 시간순으로 pageSize 개까지가 이 페이지
+    QList<CaptureCache::Entry> selected = std::exchange(request->m_cachedCandidates, {});
+    if (request->m_pageSize > 0 && !selected.isEmpty()) {
+        QString boundary;
+        if (request->m_pageImageCount >= request->m_pageSize) {
+            // 서버 페이지가 찼으면 그 마지막 이미지까지가 빠짐없이 받은 구간
+            boundary = request->m_pageCursor;
+        } else {
+            QStringList timestamps;
+            for (const ImageData &image : std::as_const(request->m_images)) {
+                if (image.imagePath.isEmpty()) {
+                    timestamps.append(image.timestamp);
+                }
+            }
+            for (const CaptureCache::Entry &entry : std::as_const(selected)) {
+                timestamps.append(entry.timestamp);
+            }
+            if (timestamps.size() > request->m_pageSize) {
+                std::sort(timestamps.begin(), timestamps.end());
+                // 서버가 이미 보낸 이미지는 모두 이 페이지에 남긴다
+                boundary = qMax(timestamps.at(request->m_pageSize - 1), request->m_pageCursor);
+                request->m_pageCursor = boundary;
+                request->m_moreCached = true;
+            }
+        }
+        if (!boundary.isEmpty()) {
+            selected.erase(std::remove_if(selected.begin(), selected.end(), [&boundary](const CaptureCache::Entry &entry) {
+                return entry.timestamp > boundary;
+            }), selected.end());
+        }
+    }
+
+    if (selected.isEmpty()) {
+        completeImageRequest(request);
+        return;
+    }
+
+    // 목록 조회면 원본 대신 썸네일 크기로 줄여서
+    request->m_cacheLoadsPending = selected.size();
+    m_captureCache->load(selected, request, [this, request](const CaptureCache::Entry &, const ImageData &image) {
+        request->m_cacheLoadsPending--;
+        if (!request->isPending()) {
+            return;
+        }
+        if (!image.encodedData.isEmpty()) {
+            deliverImage(request, image);
+        }
+        if (request->m_cacheLoadsPending == 0) {
+            completeImageRequest(request);
+        }
+    }, request->m_cacheThumbnailSize);
 }
 
-void TcpCommunicator::setReconnectEnabled(bool enabled)
+PendingRequest *TcpCommunicator::requestFullImage(const ImageData &image, int timeoutMs)
 {
-    m_reconnectEnabled = enabled;
+    const QString camera = image.cameraId.isEmpty() ? QStringLiteral("default") : image.cameraId;
+
+    // 이미 받은 원본은 캡처 캐시에서 (서버 왕복 없음)
+    QList<CaptureCache::Entry> cached = m_captureCache->find(serverKey(), image.timestamp);
+    cached.erase(std::remove_if(cached.begin(), cached.end(), [&](const CaptureCache::Entry &entry) {
+        return entry.camera != camera || entry.timestamp != image.timestamp;
+    }), cached.end());
+
+    QJsonObject data;
+    data["timestamp"] = image.timestamp;
+    if (!image.cameraId.isEmpty()) {
+        data["camera_id"] = image.cameraId;
+    }
+
+    QJsonObject message;
+    message["request_id"] = 42;
+    message["data"] = data;
+
+    if (!cached.isEmpty()) {
+        // 캐시에서 읽는 동안에도 핸들은 대기 테이블에 남겨 마감/취소/연결 끊김이 그대로 적용되게 한다
+        PendingRequest *request = m_pendingRequests->add(42, 43, timeoutMs);
+        m_captureCache->load(cached.mid(0, 1), request, [this, request, message](const CaptureCache::Entry &, const ImageData &loaded) {
+            if (!request->isPending()) {
+                return;
+            }
+            if (loaded.encodedData.isEmpty()) {
+                // 캐시 파일이 없거나 손상됨 - 같은 핸들로 서버에 요청
+                qDebug() << "[TCP] 캐시된 원본을 읽지 못함 - 서버에 요청:" << loaded.timestamp;
+                if (!isConnectedToServer() || !transmitRequest(request, message)) {
+                    m_pendingRequests->fail(request, "Failed to send request");
+                }
+                return;
+            }
+            m_pendingRequests->take(request->seq(), 43);
+            deliverImage(request, loaded);
+            m_pendingRequests->complete(request);
+        });
+        return request;
+    }
+
+    if (!isConnectedToServer()) {
+        qDebug() << "[TCP] Failed to request full image, no connection.";
+        emit errorOccurred("Not connected to server");
+        return nullptr;
+    }
+
+    PendingRequest *request = sendRequest(message, 43, timeoutMs);
+    if (request) {
+        qDebug() << "[TCP] Full image request sent - seq:" << request->seq() << "timestamp:" << image.timestamp;
+    }
+    return request;
+
 }
 
-void TcpCommunicator::onConnected()
+PendingRequest *TcpCommunicator::requestCaptureCounts(const QDate &date, CountRange range, int timeoutMs)
 {
-    m_connectionTimer->stop();
-    m_isConnected = true;
-    m_reconnectAttempts = 0;
+    if (!isConnectedToServer()) {
+        return nullptr;
+    }
 
-    qDebug() << "[TCP] Server connection successful.";
-    emit connected();
-    emit statusUpdated("Connected to server");
+    // 이미지 없이 건수만 받으므로 시간대/날짜를 고르기 전에 가볍게 물어볼 수 있다
+    QJsonObject data;
+    if (range == CountRange::Day) {
+        data["date"] = date.toString("yyyy-MM-dd");
+        data["granularity"] = "hour";
+    } else {
+        data["month"] = date.toString("yyyy-MM");
+        data["granularity"] = "day";
+    }
+
+    QJsonObject message;
+    message["request_id"] = 44;
+    message["data"] = data;
+
+    PendingRequest *request = sendRequest(message, 45, timeoutMs);
+    if (request) {
+        qDebug() << "[TCP] Capture count request sent - seq:" << request->seq() << data;
+    }
+    return request;
 }
 
-void TcpCommunicator::onDisconnected()
+void TcpCommunicator::setConnectionTimeout(int timeoutMs)
 {
-    m_isConnected = false;
-    qDebug() << "[TCP] Disconnected from server.";
+    m_connectionTimeoutMs = timeoutMs;
+    applyStageTimeouts();
+}
 
-    // Add log for socket state
-    qDebug() << "[TCP] Socket state:" << m_socket->state();
-    qDebug() << "[TCP] Socket error:" << m_socket->errorString();
+void TcpCommunicator::setStageTimeouts(int resolveMs, int connectMs, int handshakeMs)
+{
+    m_resolveTimeoutMs = resolveMs;
+    m_connectionTimeoutMs = connectMs;
+    m_handshakeTimeoutMs = handshakeMs;
+    applyStageTimeouts();
+}
 
-    emit disconnected();
-    emit statusUpdated("Disconnected from server");
+void TcpCommunicator::setTlsSessionCacheFile(const QString &filePath)
+{
+    QMetaObject::invokeMethod(m_ioWorker, [worker = m_ioWorker, filePath]() {
+        worker->setSessionCacheFile(filePath);
+    }, Qt::QueuedConnection);
+}
 
-    // Attempt reconnection only on unexpected disconnections
-    if (m_reconnectEnabled && m_reconnectAttempts < m_maxReconnectAttempts) {
-        qDebug() << "[TCP] Scheduling reconnection attempt...";
-        m_reconnectTimer->setInterval(m_reconnectDelayMs);
-        m_reconnectTimer->start();
-    }
+void TcpCommunicator::setTrafficRecordFile(const QString &filePath)
+{
+    QMetaObject::invokeMethod(m_ioWorker, [worker = m_ioWorker, filePath]() {
+        worker->setTrafficRecordFile(filePath);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::onReadyRead()
+void TcpCommunicator::setCaptureCache(const QString &directory, qint64 quotaBytes)
 {
-    static QByteArray buffer;
-    static quint32 expectedLength = 0;
-    static bool lengthReceived = false;
+    m_captureCache->open(directory, quotaBytes);
+}
 
-    // Read all available data from the socket
-    QByteArray newData = m_socket->readAll();
-    buffer.append(newData);
+QString TcpCommunicator::serverKey() const
+{
+    return QString("%1:%2").arg(m_host).arg(m_port);
+}
 
-    qDebug() << "[TCP] Data received:" << newData.size() << "bytes, Total buffer size:" << buffer.size();
+void TcpCommunicator::negotiatePayloadEncoding()
+{
+    m_cborRequested = true;
 
-    while (true) {
-        // Step 1: Read message length (4 bytes)
-        if (!lengthReceived) {
-            if (buffer.size() < 4) {
-                // Length information has not fully arrived
-                break;
-            }
+    if (!isConnectedToServer()) {
+        // 연결되면 onConnectionStateChanged(Ready) 에서 다시 시도
+        return;
+    }
 
-            // Extract length information
-            QDataStream lengthStream(buffer.left(4));
-            lengthStream.setByteOrder(QDataStream::BigEndian);
-            lengthStream >> expectedLength;
+    // 능력 협상 요청 (request_id: 30) - 서버가 31 로 사용할 인코딩을 알려준다.
+    // 응답이 없거나 모르는 요청으로 처리되면 JSON 을 계속 사용한다.
+    QJsonObject message;
+    message["request_id"] = 30;
+    message["encodings"] = QJsonArray{ "cbor", "json" };
+    message["cbor_key_table"] = PayloadCodec::KeyTableVersion;
+    message["bbox_formats"] = QJsonArray{ "binary", "json" };   // response_id 200 바이너리 프레임 (BBoxFrame)
 
-            buffer.remove(0, 4); // Remove length information
-            lengthReceived = true;
+    PendingRequest *request = sendRequest(message, 31, 5000);
+    if (!request) {
+        return;
+    }
 
-            qDebug() << "[TCP] Message length received:" << expectedLength << "bytes";
+    connect(request, &PendingRequest::finished, this, [this, request]() {
+        PayloadCodec::Encoding encoding = PayloadCodec::Encoding::Json;
+        const QString name = request->reply()["encoding"].toString();
+        if (!PayloadCodec::encodingFromName(name, encoding)) {
+            qDebug() << "[TCP] 알 수 없는 페이로드 인코딩 응답:" << name << "- JSON 사용";
+            encoding = PayloadCodec::Encoding::Json;
         }
+        m_payloadEncoding = encoding;
+        qDebug() << "[TCP] 페이로드 인코딩 협상 완료:" << PayloadCodec::encodingName(encoding);
+    });
+    connect(request, &PendingRequest::timedOut, this, []() {
+        qDebug() << "[TCP] 서버가 인코딩 협상을 지원하지 않음 - JSON 사용";
+    });
+}
 
-        // Step 2: Read the actual message data
-        if (lengthReceived) {
-            if (buffer.size() < expectedLength) {
-                // The message has not fully arrived
-                qDebug() << "[TCP] Waiting for message... Current:" << buffer.size() << "/ Required:" << expectedLength;
-                break;
-            }
+void TcpCommunicator::startClockSync(int intervalMs)
+{
+    m_clockSyncIntervalMs = intervalMs;
+    m_clockSyncTimer->stop();
+    if (intervalMs <= 0) {
+        return;
+    }
 
-            // Extract the complete message
-            QByteArray messageData = buffer.left(expectedLength);
-            buffer.remove(0, expectedLength);
-
-            // Reset state
-            lengthReceived = false;
-            expectedLength = 0;
-
-            qDebug() << "[TCP] Complete message received:" << messageData.size() << "bytes";
-
-            // JSON parsing and processing
-            QString messageString = QString::fromUtf8(messageData);
-            QJsonParseError error;
-            QJsonDocument doc = QJsonDocument::fromJson(messageData, &error);
-
-            if (error.error == QJsonParseError::NoError && doc.isObject()) {
-                QJsonObject jsonObj = doc.object();
-                logJsonMessage(jsonObj, false);
-                processJsonMessage(jsonObj);
-            } else {
-                qDebug() << "[TCP] JSON parsing error:" << error.errorString();
-                qDebug() << "[TCP] Original message:" << messageString.left(200) << "...";
-                emit messageReceived(messageString);
-            }
-        }
+    m_clockSync.reset();
+    m_clockSyncFailures = 0;
+    m_clockSyncBurstRemaining = ClockSyncBurstCount;
+    if (isConnectedToServer()) {
+        // 연결되어 있지 않으면 onConnectionStateChanged(Ready) 에서 다시 시작
+        sendClockPing();
     }
 }
 
-void TcpCommunicator::onError(QAbstractSocket::SocketError error)
+void TcpCommunicator::stopClockSync()
 {
-    m_connectionTimer->stop();
-    m_isConnected = false;
+    m_clockSyncIntervalMs = 0;
+    m_clockSyncTimer->stop();
+}
 
-    QString errorString;
-    switch (error) {
-    case QAbstractSocket::ConnectionRefusedError:
-        errorString = "Connection refused. Please check if the server is running.";
-        break;
-    case QAbstractSocket::RemoteHostClosedError:
-        errorString = "The remote host closed the connection.";
-        break;
-    case QAbstractSocket::HostNotFoundError:
-        errorString = "Host not found. Please check the IP address.";
-        break;
-    case QAbstractSocket::SocketTimeoutError:
-        errorString = "Connection timed out.";
-        break;
-    case QAbstractSocket::NetworkError:
-        errorString = "A network error occurred.";
-        break;
-    default:
-        errorString = QString("Socket error: %1").arg(m_socket->errorString());
-        break;
+void TcpCommunicator::sendClockPing()
+{
+    if (m_clockSyncIntervalMs <= 0 || !isConnectedToServer()) {
+        return;
     }
 
-    qDebug() << "[TCP] Socket error:" << errorString;
-    emit errorOccurred(errorString);
+    // 다음 핑 예약 (연결 직후에는 짧은 간격으로 표본을 모음)
+    if (m_clockSyncBurstRemaining > 0) {
+        m_clockSyncBurstRemaining--;
+        m_clockSyncTimer->start(ClockSyncBurstIntervalMs);
+    } else {
+        m_clockSyncTimer->start(m_clockSyncIntervalMs);
+    }
+
+    // 앞에 보낼 데이터가 남아 있으면 그만큼 왕복 시간이 부풀려진 표본만 나오므로 이번 회차는 건너뜀
+    if (m_clockPingInFlight || m_writeBackpressured || pendingWriteBytes() > 0) {
+        return;
+    }
+
+    // 시계 동기화 요청 (request_id: 46) - 서버는 47 로 받은 시각과 보낸 시각(에포크 us)을 돌려준다.
+    QJsonObject message;
+    message["request_id"] = 46;
+    message["client_send_us"] = ClockSync::monotonicUs();   // 서버가 그대로 돌려줌 (디버깅용)
 
-    // Attempt reconnection
-    if (m_reconnectEnabled && m_reconnectAttempts < m_maxReconnectAttempts) {
-        m_reconnectTimer->setInterval(m_reconnectDelayMs);
-        m_reconnectTimer->start();
+    PendingRequest *request = sendRequest(message, 47, ClockSyncTimeoutMs);
+    if (!request) {
+        return;
     }
+    // t0 는 송신 버퍼에 넣을 때 찍히므로 모아 보내기를 기다리지 않고 바로 I/O 스레드로 넘김
+    flushOutbound();
+    m_clockPingInFlight = true;
+
+    connect(request, &PendingRequest::finished, this, [this, request]() {
+        m_clockPingInFlight = false;
+        m_clockSyncFailures = 0;
+
+        const QJsonObject reply = request->reply();
+        const QJsonObject data = reply["data"].isObject() ? reply["data"].toObject() : reply;
+        qint64 serverReceiveUs;
+        qint64 serverSendUs;
+        if (data.contains("server_recv_us") && data.contains("server_send_us")) {
+            serverReceiveUs = data["server_recv_us"].toInteger();
+            serverSendUs = data["server_send_us"].toInteger();
+        } else if (data.contains("server_time_ms")) {
+            // 시각 하나만 주는 서버: 처리 시간이 왕복 시간에 포함됨
+            serverReceiveUs = serverSendUs = data["server_time_ms"].toInteger() * 1000;
+        } else {
+            qDebug() << "[TCP] 시계 동기화 응답에 서버 시각 없음";
+            return;
+        }
+
+        m_clockSync.addSample(request->sentUs(), serverReceiveUs, serverSendUs, request->receivedUs());
+        qDebug() << "[TCP] 시계 동기화 - offset:" << clockOffsetMs() << "ms, rtt:" << roundTripMs()
+                 << "ms (±" << m_clockSync.roundTripVarianceUs() / 1000 << "ms), 표본:" << m_clockSync.sampleCount();
+        emit clockEstimateUpdated(clockOffsetMs(), roundTripMs());
+    });
+    connect(request, &PendingRequest::timedOut, this, [this]() {
+        m_clockPingInFlight = false;
+        if (++m_clockSyncFailures >= ClockSyncMaxFailures) {
+            qDebug() << "[TCP] 서버가 시계 동기화를 지원하지 않음 - 시스템 시계 사용";
+            m_clockSyncTimer->stop();
+        }
+    });
+    connect(request, &PendingRequest::failed, this, [this]() {
+        m_clockPingInFlight = false;
+    });
 }
 
-void TcpCommunicator::onConnectionTimeout()
+TcpCommunicator::HandshakeStats TcpCommunicator::handshakeStats() const
 {
-    qDebug() << "[TCP] Connection timeout.";
-    m_socket->abort();
-    emit errorOccurred("Connection timed out.");
+    return m_handshakeStats;
 }
 
-void TcpCommunicator::attemptReconnection()
+void TcpCommunicator::onHandshakeCompleted(qint64 elapsedMs, bool resumed)
 {
-    if (m_reconnectAttempts >= m_maxReconnectAttempts) {
-        qDebug() << "[TCP] Maximum reconnection attempts exceeded.";
-        emit errorOccurred("Exceeded maximum reconnection attempts.");
-        return;
+    // resumed 는 캐시된 세션 티켓을 제시한 연결 (서버 수락 여부는 Qt가 노출하지 않음)
+    if (resumed) {
+        m_handshakeStats.resumedCount++;
+        m_handshakeStats.resumedTotalMs += elapsedMs;
+    } else {
+        m_handshakeStats.fullCount++;
+        m_handshakeStats.fullTotalMs += elapsedMs;
     }
+    m_handshakeStats.lastMs = elapsedMs;
+    m_handshakeStats.lastResumed = resumed;
 
-    m_reconnectAttempts++;
-    qDebug() << "[TCP] Reconnection attempt" << m_reconnectAttempts << "/" << m_maxReconnectAttempts;
+    qDebug() << "[TCP] TLS handshake:" << elapsedMs << "ms" << (resumed ? "(resumed)" : "(full)")
+             << "- avg full:" << m_handshakeStats.fullAverageMs() << "ms /" << m_handshakeStats.fullCount
+             << ", avg resumed:" << m_handshakeStats.resumedAverageMs() << "ms /" << m_handshakeStats.resumedCount;
 
-    emit statusUpdated(QString("Reconnecting... (%1/%2)").arg(m_reconnectAttempts).arg(m_maxReconnectAttempts));
+    emit handshakeMeasured(elapsedMs, resumed);
+}
 
-    m_connectionTimer->start();
-    m_socket->connectToHostEncrypted(m_host, static_cast<qint16>(m_port));
+void TcpCommunicator::applyStageTimeouts()
+{
+    QMetaObject::invokeMethod(m_ioWorker, [worker = m_ioWorker, resolveMs = m_resolveTimeoutMs,
+                                           connectMs = m_connectionTimeoutMs,
+                                           handshakeMs = m_handshakeTimeoutMs]() {
+        worker->setStageTimeouts(resolveMs, connectMs, handshakeMs);
+    }, Qt::QueuedConnection);
 }
 
-void TcpCommunicator::onSslEncrypted() {
-    qDebug() << "[TCP] SSL encrypted connection established.";
+void TcpCommunicator::setReconnectEnabled(bool enabled)
+{
+    m_reconnectEnabled = enabled;
+    if (!enabled) {
+        stopReconnectTimer();
+    }
 }
 
-void TcpCommunicator::onSslErrors(const QList<QSslError> &errors) {
-    qDebug() << "[TCP] SSL 오류 발생 - 총" << errors.size() << "개의 오류";
-    for (const auto &err : errors) {
-        qDebug() << "[TCP] SSL Error:" << err.errorString();
+void TcpCommunicator::reconnectNow()
+{
+    if (m_manualDisconnect || m_host.isEmpty() || m_port == 0 ||
+        m_connectionState != ConnectionState::Disconnected) {
+        return;
     }
-    
-    // 개발/테스트 환경에서는 SSL 오류를 무시하여 연결 진행
-    // 프로덕션 환경에서는 적절한 인증서를 설정해야 함
-    qDebug() << "[TCP] SSL 오류 무시하고 연결 계속 진행";
-    m_socket->ignoreSslErrors();
+    qDebug() << "[TCP] 즉시 재연결 요청";
+    m_reconnectScheduler->retryNow();
 }
 
-void TcpCommunicator::onSocketConnected()
+void TcpCommunicator::setMaxFrameSize(qsizetype maxBytes)
 {
-    qDebug() << "[TCP] 소켓 연결 성공";
+    QMetaObject::invokeMethod(m_ioWorker, [worker = m_ioWorker, maxBytes]() {
+        worker->setMaxFrameSize(maxBytes);
+    }, Qt::QueuedConnection);
+}
 
+void TcpCommunicator::onConnected()
+{
     m_isConnected = true;
-    m_reconnectAttempts = 0;
-    stopReconnectTimer();
+    m_reconnectScheduler->reset();
 
+    qDebug() << "[TCP] Server connection successful (SSL encrypted).";
     emit connected();
+    emit statusUpdated("Connected to server");
 }
 
-void TcpCommunicator::onSocketDisconnected()
+void TcpCommunicator::onDisconnected()
 {
-    qDebug() << "[TCP] 소켓 연결 해제";
-
     m_isConnected = false;
+    qDebug() << "[TCP] Disconnected from server.";
+
     emit disconnected();
+    emit statusUpdated("Disconnected from server");
 
-    // 자동 재연결 시도
-    if (m_autoReconnect && !m_host.isEmpty() && m_port > 0) {
-        startReconnectTimer();
-    }
+    // Attempt reconnection only on unexpected disconnections
+    startReconnectTimer();
 }
 
-void TcpCommunicator::onSocketReadyRead()
+void TcpCommunicator::onInboundMessages()
 {
-    while (m_socket->canReadLine()) {
-        QByteArray data = m_socket->readLine();
-        QString message = QString::fromUtf8(data).trimmed();
+    // I/O 스레드가 파싱을 마친 메시지를 한 번에 가져와 GUI 스레드에서 전달
+    QList<InboundMessage> messages = m_ioWorker->takePendingMessages();
+    for (InboundMessage &message : messages) {
+        dispatchInboundMessage(message);
+        // 시그널을 받은 쪽이 복사본을 남기지 않았으면 배열을 I/O 스레드로 돌려 다음 프레임에 다시 씀
+        if (message.kind == InboundMessage::Kind::BBoxes) {
+            m_ioWorker->recycleBBoxes(std::move(message.bboxes));
+        }
+    }
+}
 
-        if (!message.isEmpty()) {
-            qDebug() << "[TCP] 메시지 수신:" << message;
+void TcpCommunicator::dispatchInboundMessage(const InboundMessage &message)
+{
+    // 스트리밍 중인 이미지 응답의 중간 결과: 요청은 그대로 두고 이미지 하나만 전달
+    if (message.kind == InboundMessage::Kind::ImageStreamItem) {
+        PendingRequest *request = m_pendingRequests->find(message.seq, message.requestId);
+        if (!request) {
+            qDebug() << "[TCP] 대기 중이 아닌 요청의 이미지 폐기 - seq:" << message.seq;
+            return;
+        }
+        for (const ImageData &image : message.images) {
+            deliverImage(request, image);
+        }
+        return;
+    }
 
-            QJsonParseError error;
-            QJsonDocument jsonDoc = QJsonDocument::fromJson(data, &error);
+    // 요청에 대한 응답이면 대기 테이블에서 짝을 찾는다
+    PendingRequest *request = nullptr;
+    const bool isReply = (message.requestId == 10 || message.requestId == 12 || message.requestId == 16 ||
+                          message.requestId == 31 || message.requestId == 41 || message.requestId == 43 ||
+                          message.requestId == 45 || message.requestId == 47);
+    if (isReply) {
+        request = m_pendingRequests->take(message.seq, message.requestId);
+        if (!request && message.seq != 0) {
+            // 취소되었거나 마감이 지난 요청의 늦은 응답
+            qDebug() << "[TCP] 대기 중이 아닌 요청의 응답 폐기 - seq:" << message.seq;
+            return;
+        }
+        if (request) {
+            request->m_receivedUs = message.receivedUs;
+        }
+    }
 
-            if (error.error == QJsonParseError::NoError && jsonDoc.isObject()) {
-                processJsonMessage(jsonDoc.object());
-            } else {
-                qDebug() << "[TCP] JSON 파싱 오류:" << error.errorString();
-                emit messageReceived(message);
+    switch (message.kind) {
+    case InboundMessage::Kind::Images:
+        qDebug() << "[TCP] Number of parsed images:" << message.images.size();
+        if (request) {
+            for (const ImageData &image : message.images) {
+                deliverImage(request, image);
+            }
+            request->m_reply = message.json;
+            finishImagePage(request);
+            return;
+        }
+        for (const ImageData &image : message.images) {
+            if (!image.thumbnailOnly) {
+                m_captureCache->store(serverKey(), image);
+            }
+        }
+        emit imagesReceived(message.images);
+        emit statusUpdated(QString("Loaded %1 images.").arg(message.images.size()));
+        break;
+    case InboundMessage::Kind::DetectionLines:
+        if (request) {
+            request->m_detectionLines = message.detectionLines;
+        }
+        handleSavedDetectionLinesResponse(message.detectionLines);
+        handleDetectionLinesFromServer(message.detectionLines);
+        break;
+    case InboundMessage::Kind::RoadLines:
+        if (request) {
+            request->m_roadLines = message.roadLines;
+        }
+        handleSavedRoadLinesResponse(message.roadLines);
+        handleRoadLinesFromServer(message.roadLines);
+        break;
+    case InboundMessage::Kind::BBoxes:
+        if (message.timestamp > 0 && m_clockSync.isValid()) {
+            // 캡처 → 수신 지연 (서버 처리 + 네트워크), 1/8 평활
+            const qint64 latencyMs = message.receivedUs / 1000 - m_clockSync.serverToLocalMs(message.timestamp);
+            m_bboxLatencyMs = m_bboxLatencyMs < 0 ? latencyMs : (7 * m_bboxLatencyMs + latencyMs) / 8;
+        }
+        emit bboxesReceived(message.bboxes, message.timestamp);
+        break;
+    case InboundMessage::Kind::Error:
+        qDebug() << "[TCP] Inbound error:" << message.text;
+        emit errorOccurred(message.text);
+        break;
+    case InboundMessage::Kind::RawText:
+        qDebug() << "[TCP] Original message:" << message.text.left(200) << "...";
+        emit messageReceived(message.text);
+        break;
+    case InboundMessage::Kind::Json:
+        if (message.requestId == 45) {
+            // 건수 집계: data 가 배열이거나 {"counts": [...]}
+            const QJsonValue data = message.json["data"];
+            const QJsonArray counts = data.isArray() ? data.toArray() : data.toObject()["counts"].toArray();
+            if (request) {
+                for (const QJsonValue &count : counts) {
+                    request->m_counts.append(count.toInt());
+                }
             }
+            break;
+        }
+        if (message.requestId == 47) {
+            // 시계 동기화 응답은 요청 핸들에서 처리 (sendClockPing)
+            break;
+        }
+        processJsonMessage(message.json);
+        break;
+    case InboundMessage::Kind::ImageStreamItem:
+        break;
+    }
+
+    if (request) {
+        if (message.kind == InboundMessage::Kind::Error) {
+            m_pendingRequests->fail(request, message.text);
+        } else {
+            request->m_reply = message.json;
+            m_pendingRequests->complete(request);
         }
     }
 }
 
-void TcpCommunicator::onSocketError(QAbstractSocket::SocketError error)
+void TcpCommunicator::deliverImage(PendingRequest *request, const ImageData &image)
 {
-    QString errorString = m_socket->errorString();
-    qDebug() << "[TCP] 소켓 오류:" << error << "-" << errorString;
+    // 캐시, 스트리밍 중간 결과, 최종 응답에 같은 이미지가 겹쳐 올 수 있으므로 한 번만 전달
+    // 같은 초에 찍힌 다른 캡처는 내용이 다르므로 해시까지 포함
+    const QString key = image.cameraId + QChar('|') + image.timestamp + QChar('|') +
+                        QString::fromLatin1(image.contentHash.toHex());
+    if (request->m_imageKeys.contains(key)) {
+        return;
+    }
+    request->m_imageKeys.insert(key);
+
+    // 캐시에서 읽은 이미지는 imagePath 가 채워져 있음 - 다시 저장하지 않고 페이지 커서에도 넣지 않는다
+    // (서버 썸네일만 있는 목록 결과는 원본 캐시에 넣지 않음)
+    if (image.imagePath.isEmpty()) {
+        if (!image.thumbnailOnly) {
+            m_captureCache->store(serverKey(), image);
+        }
+        request->m_pageImageCount++;
+        if (image.timestamp > request->m_pageCursor) {
+            request->m_pageCursor = image.timestamp;
+        }
+    }
+    request->m_images.append(image);
+    emit request->imageReceived(image);
+}
+
+void TcpCommunicator::completeImageRequest(PendingRequest *request)
+{
+    // 백그라운드 미리 받기는 화면 상태에 섞지 않음
+    if (!request->m_quiet) {
+        emit imagesReceived(request->m_images);
+        emit statusUpdated(QString("Loaded %1 images.").arg(request->m_images.size()));
+    }
+    m_pendingRequests->complete(request);
+}
 
+void TcpCommunicator::onConnectionStateChanged(ConnectionState state)
+{
+    if (m_connectionState == state) {
+        return;
+    }
+
+    const ConnectionState previous = m_connectionState;
+    m_connectionState = state;
+    qDebug() << "[TCP] Connection state:" << connectionStateToString(state);
+    emit connectionStateChanged(state);
+
+    if (state == ConnectionState::Ready) {
+        onConnected();
+        // 새 연결은 JSON 으로 시작하므로 이전에 CBOR 를 쓰고 있었다면 다시 협상
+        if (m_cborRequested) {
+            negotiatePayloadEncoding();
+        }
+        // 경로가 바뀌었을 수 있으므로 표본을 버리고 다시 빠르게 모은다
+        if (m_clockSyncIntervalMs > 0) {
+            startClockSync(m_clockSyncIntervalMs);
+        }
+    } else if (previous == ConnectionState::Ready && state == ConnectionState::Disconnected) {
+        // 끊긴 연결로 보내려던 메시지는 버린다 (재연결 후 새 세션에 섞이지 않도록)
+        m_outbound = QByteArray();
+        m_outboundFrames = 0;
+        m_payloadEncoding = PayloadCodec::Encoding::Json;
+        m_clockSyncTimer->stop();
+        onWriteDrained();
+        m_pendingRequests->failAll("Disconnected from server");
+        onDisconnected();
+    }
+}
+
+void TcpCommunicator::onStageTimedOut(ConnectionState stage)
+{
+    QString errorString;
+    switch (stage) {
+    case ConnectionState::Resolving:
+        errorString = "Host lookup timed out.";
+        break;
+    case ConnectionState::Connecting:
+        errorString = "Connection timed out.";
+        break;
+    case ConnectionState::Handshaking:
+        errorString = "SSL handshake timed out.";
+        break;
+    default:
+        errorString = "Connection timed out.";
+        break;
+    }
+
+    qDebug() << "[TCP] Connection timeout at stage:" << connectionStateToString(stage);
     m_isConnected = false;
     emit errorOccurred(errorString);
 
-    // 자동 재연결 시도 (연결 오류인 경우)
     if (m_autoReconnect && !m_host.isEmpty() && m_port > 0) {
         startReconnectTimer();
     }
 }
 
-void TcpCommunicator::onReconnectTimer()
+void TcpCommunicator::startConnection()
+{
+    QMetaObject::invokeMethod(m_ioWorker, [worker = m_ioWorker, host = m_host, port = m_port]() {
+        worker->connectToHost(host, port);
+    }, Qt::QueuedConnection);
+}
+
+void TcpCommunicator::onSocketError(QAbstractSocket::SocketError error, const QString &errorString)
 {
-    if (m_reconnectAttempts >= m_maxReconnectAttempts) {
-        qDebug() << "[TCP] Maximum reconnection attempts exceeded.";
-        emit errorOccurred("Exceeded maximum reconnection attempts.");
+    qDebug() << "[TCP] 소켓 오류:" << error << "-" << errorString;
+
+    m_isConnected = false;
+    emit errorOccurred(errorString);
+
+    // 자동 재연결 시도 (연결 오류인 경우)
+    startReconnectTimer();
+}
+
+void TcpCommunicator::onReconnectRequested(int attempt)
+{
+    // 스케줄러가 요청한 시점에 이미 연결 중이거나 연결되어 있으면 건너뜀
+    if (m_manualDisconnect || m_connectionState != ConnectionState::Disconnected) {
         return;
     }
 
-    m_reconnectAttempts++;
-    qDebug() << "[TCP] Reconnection attempt" << m_reconnectAttempts << "/" << m_maxReconnectAttempts;
+    if (m_reconnectScheduler->neverGiveUp()) {
+        qDebug() << "[TCP] Reconnection attempt" << attempt;
+        emit statusUpdated(QString("Reconnecting... (%1)").arg(attempt));
+    } else {
+        qDebug() << "[TCP] Reconnection attempt" << attempt << "/" << m_reconnectScheduler->maxAttempts();
+        emit statusUpdated(QString("Reconnecting... (%1/%2)").arg(attempt).arg(m_reconnectScheduler->maxAttempts()));
+    }
 
-    emit statusUpdated(QString("Reconnecting... (%1/%2)").arg(m_reconnectAttempts).arg(m_maxReconnectAttempts));
+    startConnection();
+}
 
-    m_connectionTimer->start();
-    m_socket->connectToHostEncrypted(m_host, static_cast<qint16>(m_port));
+void TcpCommunicator::onReconnectGaveUp()
+{
+    qDebug() << "[TCP] Maximum reconnection attempts exceeded.";
+    emit errorOccurred("Exceeded maximum reconnection attempts.");
 }
 
 void TcpCommunicator::startReconnectTimer()
 {
-    if (!m_reconnectTimer->isActive() && m_reconnectAttempts < m_maxReconnectAttempts) {
-        qDebug() << "[TCP] 재연결 타이머 시작 (" << m_reconnectDelayMs << "ms 후)";
-        m_reconnectTimer->start();
+    if (!m_reconnectEnabled || !m_autoReconnect || m_manualDisconnect || m_host.isEmpty() || m_port == 0) {
+        return;
     }
+    m_reconnectScheduler->schedule();
 }
 
 void TcpCommunicator::stopReconnectTimer()
 {
-    if (m_reconnectTimer->isActive()) {
+    if (m_reconnectScheduler->isPending()) {
         qDebug() << "[TCP] 재연결 타이머 중지";
-        m_reconnectTimer->stop();
     }
+    m_reconnectScheduler->cancel();
 }
 
 void TcpCommunicator::processJsonMessage(const QJsonObject &jsonObj)
@@ -830,55 +1352,32 @@ void TcpCommunicator::processJsonMessage(const QJsonObject &jsonObj)
         requestId = jsonObj["response_id"].toInt();
     }
 
-    qDebug() << "[TCP] JSON 메시지 처리 - request_id/response_id:" << requestId;
-
-    // 기타 응답 처리
-    switch (requestId) {
-    case 10: // 이미지 요청 응답
-        handleImagesResponse(jsonObj);
-        break;
-    case 12:
-        handleSavedDetectionLinesResponse(jsonObj);
-        handleDetectionLinesFromServer(jsonObj);
-        break;
-    case 16:
-        handleSavedRoadLinesResponse(jsonObj);
-        handleRoadLinesFromServer(jsonObj);
-        break;
-    case 200: // BBox 데이터 응답
-        handleBBoxResponse(jsonObj);
-        break;
-    default:
-        qDebug() << "[TCP] 알 수 없는 request_id:" << requestId;
-        QJsonDocument doc(jsonObj);
-        emit messageReceived(doc.toJson(QJsonDocument::Compact));
-        break;
+    // 10, 12, 16, 200 은 I/O 스레드에서 타입별로 파싱되어 전달됨
+    // 나머지는 해당 request_id 에 등록된 핸들러에만 파싱된 객체를 그대로 넘긴다
+    if (!m_handlers.dispatch(requestId, jsonObj)) {
+        qDebug() << "[TCP] 처리할 핸들러가 없는 request_id:" << requestId;
     }
 }
 
+int TcpCommunicator::registerHandler(int requestId, QObject *context, MessageHandlerRegistry::Handler handler)
+{
+    return m_handlers.add(requestId, context, std::move(handler));
+}
+
+void TcpCommunicator::unregisterHandler(int handlerId)
+{
+    m_handlers.remove(handlerId);
+}
+
+void TcpCommunicator::unregisterHandlers(const QObject *context)
+{
+    m_handlers.removeAll(context);
+}
+
 // request_id 12: 감지선 데이터 처리 핸들러
-void TcpCommunicator::handleDetectionLinesFromServer(const QJsonObject &jsonObj)
+void TcpCommunicator::handleDetectionLinesFromServer(const QList<DetectionLineData> &detectionLines)
 {
     qDebug() << "[TCP] handleDetectionLinesFromServer 호출됨 (request_id: 12)";
-    QList<DetectionLineData> detectionLines;
-
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject detectionLineObj = dataArray[i].toObject();
-            DetectionLineData detectionLine;
-            detectionLine.index = detectionLineObj["index"].toInt();
-            detectionLine.x1 = detectionLineObj["x1"].toInt();
-            detectionLine.y1 = detectionLineObj["y1"].toInt();
-            detectionLine.x2 = detectionLineObj["x2"].toInt();
-            detectionLine.y2 = detectionLineObj["y2"].toInt();
-            detectionLine.name = detectionLineObj["name"].toString();
-            detectionLine.mode = detectionLineObj["mode"].toString();
-            // detectionLine.leftMatrixNum = detectionLineObj["leftMatrixNum"].toInt();
-            // detectionLine.rightMatrixNum = detectionLineObj["rightMatrixNum"].toInt();
-            detectionLines.append(detectionLine);
-        }
-    }
 
     // VideoGraphicsView 인스턴스에 감지선 데이터 전달
     if (m_videoView) {
@@ -888,26 +1387,9 @@ void TcpCommunicator::handleDetectionLinesFromServer(const QJsonObject &jsonObj)
     }
 }
 
-void TcpCommunicator::handleRoadLinesFromServer(const QJsonObject &jsonObj)
+void TcpCommunicator::handleRoadLinesFromServer(const QList<RoadLineData> &roadLines)
 {
     qDebug() << "[TCP] handleRoadLinesFromServer 호출됨 (request_id: 16)";
-    QList<RoadLineData> roadLines;
-
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject roadLineObj = dataArray[i].toObject();
-            RoadLineData roadLine;
-            roadLine.index = roadLineObj["index"].toInt();
-            roadLine.x1 = roadLineObj["x1"].toInt();
-            roadLine.y1 = roadLineObj["y1"].toInt();
-            roadLine.x2 = roadLineObj["x2"].toInt();
-            roadLine.y2 = roadLineObj["y2"].toInt();
-            roadLine.matrixNum1 = roadLineObj["matrixNum1"].toInt();
-            roadLine.matrixNum2 = roadLineObj["matrixNum2"].toInt();
-            roadLines.append(roadLine);
-        }
-    }
 
     // VideoGraphicsView 인스턴스에 감지선 데이터 전달
     if (m_videoView) {
@@ -917,81 +1399,6 @@ void TcpCommunicator::handleRoadLinesFromServer(const QJsonObject &jsonObj)
     }
 }
 
-QString TcpCommunicator::saveBase64Image(const QString &base64Data, const QString &timestamp)
-{
-    QString cleanBase64 = base64Data;
-    if (cleanBase64.contains(",")) {
-        cleanBase64 = cleanBase64.split(",").last();
-    }
-
-    QByteArray imageData = QByteArray::fromBase64(cleanBase64.toUtf8());
-
-    QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-    QString cleanTimestamp = timestamp;
-    cleanTimestamp.replace(":", "_").replace("-", "_");
-    QString fileName = QString("CCTVImage%1.jpg").arg(cleanTimestamp);
-    QString filePath = QDir(tempDir).absoluteFilePath(fileName);
-
-    QFile file(filePath);
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(imageData);
-        file.close();
-        qDebug() << "[TCP] Base64 image saved successfully:" << filePath;
-        return filePath;
-    } else {
-        qDebug() << "[TCP] Failed to save Base64 image:" << filePath;
-        return QString();
-    }
-}
-
-void TcpCommunicator::handleImagesResponse(const QJsonObject &jsonObj)
-{
-    qDebug() << "[TCP] Processing image response...";
-
-    if (!jsonObj.contains("data")) {
-        qDebug() << "[TCP] 'data' field not found in response.";
-        emit errorOccurred("The 'data' field is missing in the server response.");
-        return;
-    }
-
-    QJsonArray dataArray = jsonObj["data"].toArray();
-    qDebug() << "[TCP] Size of data array:" << dataArray.size();
-
-    QList<ImageData> images;
-
-    for (int i = 0; i < dataArray.size(); ++i) {
-        QJsonValue value = dataArray[i];
-        if (!value.isObject()) {
-            qDebug() << "[TCP] data[" << i << "] is not an object.";
-            continue;
-        }
-
-        QJsonObject imageObj = value.toObject();
-
-        if (!imageObj.contains("image") || !imageObj.contains("timestamp")) {
-            qDebug() << "[TCP] Image object[" << i << "] is missing required fields.";
-            continue;
-        }
-
-        ImageData imageData;
-        QString base64Image = imageObj["image"].toString();
-        imageData.timestamp = imageObj["timestamp"].toString();
-
-        imageData.imagePath = saveBase64Image(base64Image, imageData.timestamp);
-        imageData.logText = QString("Detection time: %1").arg(imageData.timestamp);
-        imageData.detectionType = "vehicle";
-        imageData.direction = "unknown";
-
-        if (!imageData.imagePath.isEmpty()) {
-            images.append(imageData);
-        }
-    }
-
-    qDebug() << "[TCP] Number of parsed images:" << images.size();
-    emit imagesReceived(images);
-    emit statusUpdated(QString("Loaded %1 images.").arg(images.size()));
-}
-
 void TcpCommunicator::handleCoordinatesResponse(const QJsonObject &jsonObj)
 {
     bool success = jsonObj["success"].toBool();
@@ -1122,35 +1529,17 @@ void TcpCommunicator::handlePerpendicularLineResponse(const QJsonObject &jsonObj
     }
 }
 
-// 저장된 도로선 데이터 응답 처리 함수 (request_id: 7)
-void TcpCommunicator::handleSavedRoadLinesResponse(const QJsonObject &jsonObj)
+// 저장된 도로선 데이터 응답 처리 함수 (request_id: 16)
+void TcpCommunicator::handleSavedRoadLinesResponse(const QList<RoadLineData> &roadLines)
 {
-    qDebug() << "[TCP] 저장된 도로선 데이터 응답 처리 중... (request_id: 7)";
-    qDebug() << "[TCP] Full JSON:" << QJsonDocument(jsonObj).toJson(QJsonDocument::Compact);
-
-    m_receivedRoadLines.clear();
-
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
+    qDebug() << "[TCP] 저장된 도로선 데이터 응답 처리 중... (request_id: 16)";
 
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject roadLineObj = dataArray[i].toObject();
+    m_receivedRoadLines = roadLines;
 
-            RoadLineData roadLine;
-            roadLine.index = roadLineObj["index"].toInt();
-            roadLine.matrixNum1 = roadLineObj["matrixNum1"].toInt();
-            roadLine.x1 = roadLineObj["x1"].toInt();
-            roadLine.y1 = roadLineObj["y1"].toInt();
-            roadLine.matrixNum2 = roadLineObj["matrixNum2"].toInt();
-            roadLine.x2 = roadLineObj["x2"].toInt();
-            roadLine.y2 = roadLineObj["y2"].toInt();
-
-            m_receivedRoadLines.append(roadLine);
-
-            qDebug() << "[TCP] 도로선 로드됨 - index:" << roadLine.index
-                     << "start:(" << roadLine.x1 << "," << roadLine.y1 << ") matrix:" << roadLine.matrixNum1
-                     << "end:(" << roadLine.x2 << "," << roadLine.y2 << ") matrix:" << roadLine.matrixNum2;
-        }
+    for (const RoadLineData &roadLine : m_receivedRoadLines) {
+        qDebug() << "[TCP] 도로선 로드됨 - index:" << roadLine.index
+                 << "start:(" << roadLine.x1 << "," << roadLine.y1 << ") matrix:" << roadLine.matrixNum1
+                 << "end:(" << roadLine.x2 << "," << roadLine.y2 << ") matrix:" << roadLine.matrixNum2;
     }
 
     qDebug() << "[TCP] 저장된 도로선 데이터 로드 완료 - 도로선:" << m_receivedRoadLines.size() << "개";
@@ -1162,38 +1551,18 @@ void TcpCommunicator::handleSavedRoadLinesResponse(const QJsonObject &jsonObj)
     // checkAndEmitAllLinesReceived();
 }
 
-// 저장된 감지선 데이터 응답 처리 함수 (request_id: 3)
-void TcpCommunicator::handleSavedDetectionLinesResponse(const QJsonObject &jsonObj)
+// 저장된 감지선 데이터 응답 처리 함수 (request_id: 12)
+void TcpCommunicator::handleSavedDetectionLinesResponse(const QList<DetectionLineData> &detectionLines)
 {
-    qDebug() << "[TCP] 저장된 감지선 데이터 응답 처리 중... (request_id: 3)";
-    qDebug() << "[TCP] Full JSON:" << QJsonDocument(jsonObj).toJson(QJsonDocument::Compact);
+    qDebug() << "[TCP] 저장된 감지선 데이터 응답 처리 중... (request_id: 12)";
 
-    m_receivedDetectionLines.clear();
+    m_receivedDetectionLines = detectionLines;
 
-    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
-        QJsonArray dataArray = jsonObj["data"].toArray();
-
-        for (int i = 0; i < dataArray.size(); ++i) {
-            QJsonObject detectionLineObj = dataArray[i].toObject();
-
-            DetectionLineData detectionLine;
-            detectionLine.index = detectionLineObj["index"].toInt();
-            detectionLine.x1 = detectionLineObj["x1"].toInt();
-            detectionLine.y1 = detectionLineObj["y1"].toInt();
-            detectionLine.x2 = detectionLineObj["x2"].toInt();
-            detectionLine.y2 = detectionLineObj["y2"].toInt();
-            detectionLine.name = detectionLineObj["name"].toString();
-            detectionLine.mode = detectionLineObj["mode"].toString();
-            // detectionLine.leftMatrixNum = detectionLineObj["leftMatrixNum"].toInt();
-            // detectionLine.rightMatrixNum = detectionLineObj["rightMatrixNum"].toInt();
-
-            m_receivedDetectionLines.append(detectionLine);
-
-            qDebug() << "[TCP] 감지선 로드됨 - index:" << detectionLine.index
-                     << "name:" << detectionLine.name << "mode:" << detectionLine.mode
-                     << "좌표:(" << detectionLine.x1 << "," << detectionLine.y1 << ") → ("
-                     << detectionLine.x2 << "," << detectionLine.y2 << ")";
-        }
+    for (const DetectionLineData &detectionLine : m_receivedDetectionLines) {
+        qDebug() << "[TCP] 감지선 로드됨 - index:" << detectionLine.index
+                 << "name:" << detectionLine.name << "mode:" << detectionLine.mode
+                 << "좌표:(" << detectionLine.x1 << "," << detectionLine.y1 << ") → ("
+                 << detectionLine.x2 << "," << detectionLine.y2 << ")";
     }
 
     qDebug() << "[TCP] 저장된 감지선 데이터 로드 완료 - 감지선:" << m_receivedDetectionLines.size() << "개";
@@ -1283,61 +1652,7 @@ MessageType TcpCommunicator::stringToMessageType(const QString &typeStr) const
     return MessageType::ERROR_RESPONSE; // Default
 }
 
-void TcpCommunicator::logJsonMessage(const QJsonObject &jsonObj, bool outgoing) const
-{
-    QString direction = outgoing ? "Sent" : "Received";
-    int requestId = jsonObj["request_id"].toInt();
-
-    qDebug() << QString("[TCP] JSON %1 - request_id: %2").arg(direction).arg(requestId);
-
-// Only print full JSON in debug mode
-#ifdef QT_DEBUG
-    QJsonDocument doc(jsonObj);
-    qDebug() << "JSON Content:" << doc.toJson(QJsonDocument::Compact);
-#endif
-}
-
 void TcpCommunicator::setupSocket()
 {
     // 소켓 설정이 필요한 경우 여기에 구현
 }
-
-// BBox 데이터 처리 함수
-void TcpCommunicator::handleBBoxResponse(const QJsonObject &jsonObj)
-{
-    qDebug() << "[TCP] handleBBoxResponse 호출됨 (response_id: 200)";
-    
-    QList<BBox> bboxes;
-    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
-    
-    if (jsonObj.contains("bboxes") && jsonObj["bboxes"].isArray()) {
-        QJsonArray bboxArray = jsonObj["bboxes"].toArray();
-        
-        for (int i = 0; i < bboxArray.size(); ++i) {
-            QJsonObject bboxObj = bboxArray[i].toObject();
-            
-            BBox bbox;
-            bbox.object_id = bboxObj["id"].toInt();
-            bbox.type = bboxObj["type"].toString();
-            bbox.confidence = bboxObj["confidence"].toDouble();
-            bbox.rect = QRect(
-                bboxObj["x"].toInt(),
-                bboxObj["y"].toInt(),
-                bboxObj["width"].toInt(),
-                bboxObj["height"].toInt()
-            );
-            
-            bboxes.append(bbox);
-        }
-    }
-    
-    // 타임스탬프가 JSON에 포함되어 있다면 사용
-    if (jsonObj.contains("timestamp")) {
-        timestamp = jsonObj["timestamp"].toVariant().toLongLong();
-    }
-    
-    qDebug() << QString("[TCP] BBox 데이터 파싱 완료 - 총 %1개 객체").arg(bboxes.size());
-    
-    // BBox 데이터를 시그널로 전달
-    emit bboxesReceived(bboxes, timestamp);
-}
@@ -10,13 +10,24 @@
 #include <QDateTime>
 #include <QThread>
 #include <QRect>
+#include <QImage>
 
 #include <QSslSocket>
 #include <QSslError>
 #include <QSslConfiguration>
 
+#include "MessageHandlerRegistry.h"
+#include "PayloadCodec.h"
+#include "ClockSync.h"
+
 // Forward declarations
 class VideoGraphicsView;
+class ReconnectScheduler;
+class PendingRequest;
+class PendingRequestTable;
+class TcpIoWorker;
+class CaptureCache;
+struct InboundMessage;
 
 
 // 메시지 타입 열거형
@@ -31,11 +42,17 @@ enum class MessageType {
 
 // 이미지 데이터 구조체
 struct ImageData {
-    QString imagePath;
+    QString imagePath;          // 캡처 캐시 파일 (캐시를 켠 경우, 백그라운드로 기록)
+    QByteArray encodedData;     // 서버가 보낸 원본 (JPEG 등)
+    QByteArray contentHash;     // encodedData 의 SHA-256 (캐시 파일 이름)
+    QImage image;               // 전체 해상도 (필요할 때 encodedData 에서 디코드, 비어 있을 수 있음)
+    QString cameraId;           // 서버가 보내지 않으면 비어 있음
     QString timestamp;
     QString logText;
     QString detectionType;
     QString direction;
+    int lineIndex = -1;         // 탐지한 선 인덱스 (서버가 보낸 경우)
+    bool thumbnailOnly = false; // 목록 조회 결과 - encodedData 는 서버 썸네일, 원본은 requestFullImage()
 };
 
 // 객체 탐지선 데이터 구조체
@@ -85,15 +102,45 @@ class TcpCommunicator : public QObject
     Q_OBJECT
 
 public:
+    // 연결 단계 (resolve → TCP connect → TLS handshake → ready)
+    enum class ConnectionState {
+        Disconnected,
+        Resolving,
+        Connecting,
+        Handshaking,
+        Ready
+    };
+    Q_ENUM(ConnectionState)
+
+    // TLS 핸드셰이크 소요 시간 통계 (전체 vs 세션 재개)
+    struct HandshakeStats {
+        int fullCount = 0;
+        int resumedCount = 0;
+        qint64 fullTotalMs = 0;
+        qint64 resumedTotalMs = 0;
+        qint64 lastMs = 0;
+        bool lastResumed = false;
+
+        double fullAverageMs() const { return fullCount > 0 ? double(fullTotalMs) / fullCount : 0.0; }
+        double resumedAverageMs() const { return resumedCount > 0 ? double(resumedTotalMs) / resumedCount : 0.0; }
+    };
+
     explicit TcpCommunicator(QObject *parent = nullptr);
     ~TcpCommunicator();
 
-    // 연결 관리
+    static QString connectionStateToString(ConnectionState state);
+
+    static constexpr int DefaultRequestTimeoutMs = 30000;
+
+    // 연결 관리 (모두 비동기, 결과는 connectionStateChanged 로 통지)
     void connectToServer(const QString &host, quint16 port);
     void disconnectFromServer();
     bool isConnectedToServer() const;
+    ConnectionState connectionState() const;
 
     // 메시지 전송
+    // 같은 이벤트 루프 반복 안에서 보낸 메시지는 한 번의 write 로 묶여 전송된다.
+    // 송신 대기량이 high-water mark 를 넘으면 false 를 반환 (isWriteBackpressured() 참고)
     bool sendJsonMessage(const QJsonObject &message);
     bool sendMessage(const QString &message);
 
@@ -106,23 +153,91 @@ public:
     bool sendRoadLine(const RoadLineData &lineData);
     bool sendMultipleRoadLines(const QList<RoadLineData> &roadLines);
     bool sendPerpendicularLine(const PerpendicularLineData &lineData);
-    void requestImageData(const QString &date = QString(), int hour = -1);
+    // 응답을 기다리는 요청은 핸들을 돌려준다 (전송 실패 시 nullptr).
+    // 여러 요청을 한 연결에서 동시에 보낼 수 있고, 각각 마감 시간과 취소를 가진다.
+    PendingRequest *requestImageData(const QString &date = QString(), int hour = -1,
+                                     int timeoutMs = DefaultRequestTimeoutMs);
+    // 시간대를 페이지 단위로 조회: afterTimestamp 이후의 이미지를 최대 pageSize 개 (pageSize 0 이면 전부).
+    // 완료 후 PendingRequest::hasMore()/nextCursor() 로 다음 페이지를 요청한다.
+    // detail 이 Thumbnail 이면 목록 조회 (request_id 40): 메타데이터와 작은 서버 썸네일만 받는다.
+    enum class ImageDetail {
+        Full,
+        Thumbnail
+    };
+    PendingRequest *requestImagePage(const QString &date, int hour, const QString &afterTimestamp,
+                                     int pageSize, ImageDetail detail = ImageDetail::Full,
+                                     int timeoutMs = DefaultRequestTimeoutMs);
+    // requestImagePage 와 같지만 백그라운드 미리 받기용 - statusUpdated/imagesReceived/errorOccurred 를 내지 않음
+    PendingRequest *prefetchImagePage(const QString &date, int hour, const QString &afterTimestamp,
+                                      int pageSize, ImageDetail detail = ImageDetail::Full,
+                                      int timeoutMs = DefaultRequestTimeoutMs);
+    // 목록에서 고른 캡처의 원본 (request_id 42). 캡처 캐시에 있으면 서버에 묻지 않는다.
+    PendingRequest *requestFullImage(const ImageData &image, int timeoutMs = DefaultRequestTimeoutMs);
+
+    // 캡처 건수 집계 (request_id 44): Day 면 그 날의 시간별 24개, Month 면 그 달의 일별 건수.
+    // 결과는 PendingRequest::counts()
+    enum class CountRange {
+        Day,
+        Month
+    };
+    PendingRequest *requestCaptureCounts(const QDate &date, CountRange range,
+                                         int timeoutMs = DefaultRequestTimeoutMs);
 
     // 저장된 선 데이터 요청
     bool requestSavedRoadLines();
     bool requestSavedDetectionLines();
     bool requestDeleteLines();
 
+    // 수신 메시지 핸들러 (request_id 별, 이미 파싱된 JSON 객체를 받음)
+    // context 가 삭제되면 자동으로 호출되지 않으며, 반환된 id 나 context 로 해제할 수 있다.
+    int registerHandler(int requestId, QObject *context, MessageHandlerRegistry::Handler handler);
+    void unregisterHandler(int handlerId);
+    void unregisterHandlers(const QObject *context);
+
     // 설정
     void setConnectionTimeout(int timeoutMs);
+    void setStageTimeouts(int resolveMs, int connectMs, int handshakeMs);
+    void setTlsSessionCacheFile(const QString &filePath);   // 빈 경로면 메모리 캐시만 사용
+    HandshakeStats handshakeStats() const;
+
+    // 페이로드 인코딩 협상 (로그인 후 호출, 재연결 시 자동으로 다시 협상)
+    void negotiatePayloadEncoding();
+    PayloadCodec::Encoding payloadEncoding() const { return m_payloadEncoding; }
+    void setTrafficRecordFile(const QString &filePath);     // 수신 프레임 기록 (벤치마크 입력)
+    void setCaptureCache(const QString &directory, qint64 quotaBytes);  // 받은 캡처를 디스크에 캐시 (재요청 시 서버에서 다시 받지 않음)
     void setReconnectEnabled(bool enabled);
+    // 끊긴 상태에서 사용자가 바로 재시도할 때 - 재연결 스케줄러를 거침 (disconnectFromServer 로 끊었으면 무시)
+    void reconnectNow();
+    ReconnectScheduler *reconnectScheduler() const { return m_reconnectScheduler; }
+    void setMaxFrameSize(qsizetype maxBytes);
+    void setWriteHighWaterMark(qint64 bytes);
+    bool isWriteBackpressured() const { return m_writeBackpressured; }
+    qint64 pendingWriteBytes() const;
+    int pendingRequestCount() const;                        // 응답을 기다리는 요청 수
     void setVideoView(VideoGraphicsView* videoView);
 
+    // 서버와의 시계 차이/왕복 시간 추정 (request_id 46 → 47 타임스탬프 핑, 로그인 후 호출)
+    // 연결 직후 짧은 간격으로 몇 번 교환한 뒤 intervalMs 마다 반복, 재연결 시 다시 시작한다.
+    void startClockSync(int intervalMs);
+    void stopClockSync();
+    bool hasClockEstimate() const { return m_clockSync.isValid(); }
+    qint64 clockOffsetMs() const { return m_clockSync.offsetUs() / 1000; }     // 서버 - 로컬 단조
+    qint64 roundTripMs() const { return m_clockSync.roundTripUs() / 1000; }
+    // 서버 타임스탬프(에포크 ms) → 로컬 단조 시각 (ClockSync::monotonicMs 기준)
+    // 추정 전에는 시스템 시계가 서버와 맞다고 가정한다.
+    qint64 serverToLocalMs(qint64 serverMs) const { return m_clockSync.serverToLocalMs(serverMs); }
+    qint64 serverToLocalOffsetMs() const { return m_clockSync.serverToLocalOffsetMs(); }
+    // 캡처(서버 타임스탬프) → 수신까지 BBox 전달 지연의 평활값 (측정 전 -1)
+    qint64 bboxLatencyMs() const { return m_bboxLatencyMs; }
+
 signals:
     void connected();
     void disconnected();
+    void connectionStateChanged(TcpCommunicator::ConnectionState state);
+    void handshakeMeasured(qint64 elapsedMs, bool resumed);
+    void writeBackpressureChanged(bool active);
     void errorOccurred(const QString &error);
-    void messageReceived(const QString &message);
+    void messageReceived(const QString &message);   // JSON 이 아닌 텍스트 메시지만 (JSON 은 registerHandler 사용)
     void imagesReceived(const QList<ImageData> &images);
     void coordinatesConfirmed(bool success, const QString &message);
     void detectionLineConfirmed(bool success, const QString &message);
@@ -139,80 +254,116 @@ signals:
     // BBox 관련 시그널
     void bboxesReceived(const QList<BBox> &bboxes, qint64 timestamp);
 
+    // 시계 추정이 갱신될 때마다 (핑 응답 하나)
+    void clockEstimateUpdated(qint64 offsetMs, qint64 roundTripMs);
+
 
 private slots:
     void onConnected();
     void onDisconnected();
-    void onReadyRead();
-    void onError(QAbstractSocket::SocketError error);
+    void onInboundMessages();
 
-    void onConnectionTimeout();
-    void attemptReconnection();
-    void onSslEncrypted();
-    void onSslErrors(const QList<QSslError> &errors);
+    void onConnectionStateChanged(TcpCommunicator::ConnectionState state);
+    void onStageTimedOut(TcpCommunicator::ConnectionState stage);
+    void onHandshakeCompleted(qint64 elapsedMs, bool resumed);
+    void flushOutbound();
+    void onWriteDrained();
+    void onRequestAbandoned(quint32 seq);
+    void sendClockPing();
 
-    void onSocketConnected();
-    void onSocketDisconnected();
-    void onSocketReadyRead();
-    void onSocketError(QAbstractSocket::SocketError error);
-    void onReconnectTimer();
+    void onSocketError(QAbstractSocket::SocketError error, const QString &errorString);
+    void onReconnectRequested(int attempt);
+    void onReconnectGaveUp();
 
 private:
     // JSON 메시지 처리
+    void dispatchInboundMessage(const InboundMessage &message);
+    PendingRequest *sendRequest(QJsonObject message, int responseId, int timeoutMs);
+    bool transmitRequest(PendingRequest *request, QJsonObject message);     // 이미 등록된 핸들로 전송
+    PendingRequest *sendImagePageRequest(const QString &date, int hour, const QString &afterTimestamp,
+                                         int pageSize, ImageDetail detail, int timeoutMs, bool quiet);
+    void finishImagePage(PendingRequest *request);
+    void deliverImage(PendingRequest *request, const ImageData &image);
+    void completeImageRequest(PendingRequest *request);
+    QString serverKey() const;
     void processJsonMessage(const QJsonObject &jsonObj);
-    void handleImagesResponse(const QJsonObject &jsonObj);
     void handleCoordinatesResponse(const QJsonObject &jsonObj);
     void handleDetectionLineResponse(const QJsonObject &jsonObj);
     void handleCategorizedCoordinatesResponse(const QJsonObject &jsonObj);
     void handleStatusUpdate(const QJsonObject &jsonObj);
     void handleErrorResponse(const QJsonObject &jsonObj);
 
-    // Base64 이미지 처리 함수 추가
-    QString saveBase64Image(const QString &base64Data, const QString &timestamp);
-
     // 유틸리티 함수
     QJsonObject createBaseMessage(const QString &type) const;
     QString messageTypeToString(MessageType type) const;
     MessageType stringToMessageType(const QString &typeStr) const;
-    void logJsonMessage(const QJsonObject &jsonObj, bool outgoing) const;
     void setupSocket();
+    void startConnection();
+    void applyStageTimeouts();
     void startReconnectTimer();
     void stopReconnectTimer();
 
-    // 네트워크 관련
-    QSslSocket *m_socket;
-    QTimer *m_connectionTimer;
-    QTimer *m_reconnectTimer;
+    // 네트워크 관련 (소켓은 I/O 스레드의 TcpIoWorker가 소유)
+    QThread *m_ioThread;
+    TcpIoWorker *m_ioWorker;
+    ReconnectScheduler *m_reconnectScheduler;
     QString m_host;
     quint16 m_port;
     bool m_isConnected;
+    bool m_manualDisconnect;     // disconnectFromServer() 로 끊은 경우 재연결하지 않음
+    ConnectionState m_connectionState;
+    HandshakeStats m_handshakeStats;
+
+    // 송신 큐 (길이 헤더 + 페이로드를 이어 붙인 버퍼, 이벤트 루프 반복마다 한 번 flush)
+    QByteArray m_outbound;
+    int m_outboundFrames;
+    bool m_flushScheduled;
+    qint64 m_writeHighWaterMark;
+    bool m_writeBackpressured;
+
+    // seq 별 응답 대기 요청
+    PendingRequestTable *m_pendingRequests;
+    MessageHandlerRegistry m_handlers;
+    CaptureCache *m_captureCache;
+
+    // 송신 페이로드 인코딩 (수신은 프레임마다 자동 판별)
+    PayloadCodec::Encoding m_payloadEncoding;
+    bool m_cborRequested;
+
+    // 시계 동기화 (타임스탬프 핑)
+    static constexpr int ClockSyncBurstCount = 4;
+    static constexpr int ClockSyncBurstIntervalMs = 500;
+    static constexpr int ClockSyncTimeoutMs = 3000;
+    static constexpr int ClockSyncMaxFailures = 3;
+    ClockSync m_clockSync;
+    QTimer *m_clockSyncTimer;
+    int m_clockSyncIntervalMs;          // 0 이면 사용 안 함
+    int m_clockSyncBurstRemaining;      // 연결 직후 짧은 간격으로 보낼 핑 수
+    int m_clockSyncFailures;            // 연속 타임아웃 (서버가 지원하지 않으면 중단)
+    bool m_clockPingInFlight;
+    qint64 m_bboxLatencyMs;
     QString m_receivedData;
 
     bool m_autoReconnect;
 
     VideoGraphicsView *m_videoView;
 
-    // 설정
+    // 설정 (단계별 연결 타임아웃)
+    int m_resolveTimeoutMs;
     int m_connectionTimeoutMs;
+    int m_handshakeTimeoutMs;
     bool m_reconnectEnabled;
-    int m_reconnectAttempts;
-    int m_maxReconnectAttempts;
-    int m_reconnectDelayMs;
 
     // private 섹션에 함수 선언 추가
     void handleRoadLineResponse(const QJsonObject &jsonObj);
     void handlePerpendicularLineResponse(const QJsonObject &jsonObj);
-    void setupSslConfiguration();
-
-    // 저장된 선 데이터 응답 처리 함수들
-    void handleSavedRoadLinesResponse(const QJsonObject &jsonObj);
-    void handleSavedDetectionLinesResponse(const QJsonObject &jsonObj);
 
-    void handleDetectionLinesFromServer(const QJsonObject &jsonObj);
-    void handleRoadLinesFromServer(const QJsonObject &jsonObj);
+    // 저장된 선 데이터 응답 처리 함수들 (I/O 스레드에서 파싱된 결과)
+    void handleSavedRoadLinesResponse(const QList<RoadLineData> &roadLines);
+    void handleSavedDetectionLinesResponse(const QList<DetectionLineData> &detectionLines);
 
-    // BBox 처리 함수
-    void handleBBoxResponse(const QJsonObject &jsonObj);
+    void handleDetectionLinesFromServer(const QList<DetectionLineData> &detectionLines);
+    void handleRoadLinesFromServer(const QList<RoadLineData> &roadLines);
 
     // 저장된 선 데이터 관리
     QList<RoadLineData> m_receivedRoadLines;
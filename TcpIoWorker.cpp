@@ -0,0 +1,827 @@
+#include "TcpIoWorker.h"
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QCryptographicHash>
+#include <QtEndian>
+
+#include "PayloadCodec.h"
+#include "BBoxFrame.h"
+#include "ThumbnailCache.h"
+#include "ClockSync.h"
+#include <utility>
+
+TcpIoWorker::TcpIoWorker(QObject *parent)
+    : QObject(parent)
+    , m_socket(nullptr)
+    , m_streamRemaining(0)
+    , m_streamDiscard(false)
+    , m_streamSeqChecked(false)
+    , m_streamedImageCount(0)
+    , m_state(TcpCommunicator::ConnectionState::Disconnected)
+    , m_stageTimer(nullptr)
+    , m_resolveTimeoutMs(5000)
+    , m_connectTimeoutMs(10000)
+    , m_handshakeTimeoutMs(10000)
+    , m_port(0)
+    , m_offeredTicket(false)
+    , m_trafficRecord(nullptr)
+    , m_postedWriteBytes(0)
+    , m_socketWriteBytes(0)
+    , m_drainLowWaterMark(0)
+    , m_queueCapacity(DefaultQueueCapacity)
+    , m_stopping(false)
+{
+}
+
+TcpIoWorker::~TcpIoWorker()
+{
+}
+
+void TcpIoWorker::initialize()
+{
+    // 소켓은 반드시 I/O 스레드 안에서 생성해야 스레드 친화성이 맞는다
+    m_socket = new QSslSocket(this);
+    setupSslConfiguration();
+
+    // Keep-Alive settings
+    m_socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    // 단계별 타임아웃 타이머 (I/O 스레드 소유)
+    m_stageTimer = new QTimer(this);
+    m_stageTimer->setSingleShot(true);
+    connect(m_stageTimer, &QTimer::timeout, this, &TcpIoWorker::onStageTimeout);
+
+    // 상태 머신 전이: hostFound → connected → encrypted
+    connect(m_socket, &QSslSocket::hostFound, this, [this]() {
+        setState(TcpCommunicator::ConnectionState::Connecting);
+        m_stageTimer->start(m_connectTimeoutMs);
+    });
+    connect(m_socket, &QSslSocket::connected, this, [this]() {
+        setState(TcpCommunicator::ConnectionState::Handshaking);
+        m_stageTimer->start(m_handshakeTimeoutMs);
+        m_handshakeTimer.start();
+    });
+    connect(m_socket, &QSslSocket::encrypted, this, [this]() {
+        m_stageTimer->stop();
+        emit handshakeCompleted(m_handshakeTimer.elapsed(), m_offeredTicket);
+        storeSessionTicket();
+        setState(TcpCommunicator::ConnectionState::Ready);
+    });
+    // TLS 1.3 은 핸드셰이크 이후에 티켓을 보내므로 별도로 받아 둔다
+    connect(m_socket, &QSslSocket::newSessionTicketReceived, this, &TcpIoWorker::storeSessionTicket);
+    connect(m_socket, &QSslSocket::stateChanged, this, &TcpIoWorker::onSocketStateChanged);
+    connect(m_socket, &QSslSocket::readyRead, this, &TcpIoWorker::onReadyRead);
+    connect(m_socket, &QSslSocket::bytesWritten, this, &TcpIoWorker::onBytesWritten);
+    connect(m_socket, &QSslSocket::encryptedBytesWritten, this, &TcpIoWorker::onBytesWritten);
+    connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QSslSocket::errorOccurred),
+            this, &TcpIoWorker::onSocketError);
+    connect(m_socket, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
+            this, &TcpIoWorker::onSslErrors);
+
+    qDebug() << "[TCP-IO] I/O 스레드 초기화 완료:" << QThread::currentThread();
+}
+
+void TcpIoWorker::setupSslConfiguration()
+{
+    QSslConfiguration sslConfiguration = QSslConfiguration::defaultConfiguration();
+
+    // 세션 티켓을 받아 재연결 시 재사용할 수 있도록 허용
+    sslConfiguration.setSslOption(QSsl::SslOptionDisableSessionTickets, false);
+    sslConfiguration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+
+    // Load server's CA certificate
+    QList<QSslCertificate> caCerts = QSslCertificate::fromPath(":/ca-cert.crt");
+    if (!caCerts.isEmpty()) {
+        qDebug() << "[TCP-IO] CA certificates loaded:" << caCerts.size() << "items";
+        sslConfiguration.setCaCertificates(caCerts);
+    } else {
+        qDebug() << "[TCP-IO] Warning: ca-cert.crt file not found or could not be read.";
+        qDebug() << "[TCP-IO] SSL 인증서 검증을 완화하여 연결을 시도합니다.";
+    }
+
+    m_socket->setSslConfiguration(sslConfiguration);
+
+    // 개발 환경에서는 VerifyNone으로 설정하여 연결 문제 해결
+    m_socket->setPeerVerifyMode(QSslSocket::VerifyNone);
+    qDebug() << "[TCP-IO] SSL Peer verification mode set to VerifyNone for development";
+}
+
+void TcpIoWorker::connectToHost(const QString &host, quint16 port)
+{
+    if (!m_socket) {
+        return;
+    }
+
+    // 이미 연결되어 있으면 즉시 끊고 새로 연결 (블로킹 대기 없음)
+    if (m_socket->state() != QAbstractSocket::UnconnectedState) {
+        qDebug() << "[TCP-IO] 기존 연결 해제 중... 현재 상태:" << m_socket->state();
+        m_socket->abort();
+    }
+
+    // 이전 세션의 미완성 프레임이 새 연결에 섞이지 않도록 초기화
+    m_frameDecoder.reset();
+    resetImageStream();
+    {
+        QMutexLocker locker(&m_ignoredMutex);
+        m_ignoredReplies.clear();
+    }
+
+    // 캐시된 세션 티켓이 있으면 제시해 핸드셰이크를 단축 (없으면 이전 티켓을 비운다)
+    m_host = host;
+    m_port = port;
+    const QByteArray ticket = m_sessionCache.ticket(host, port);
+    QSslConfiguration sslConfiguration = m_socket->sslConfiguration();
+    sslConfiguration.setSessionTicket(ticket);
+    m_socket->setSslConfiguration(sslConfiguration);
+    m_offeredTicket = !ticket.isEmpty();
+
+    qDebug() << "[TCP-IO] 서버 연결 시도:" << host << ":" << port
+             << (m_offeredTicket ? "(세션 재개 시도)" : "(전체 핸드셰이크)");
+    setState(TcpCommunicator::ConnectionState::Resolving);
+    m_stageTimer->start(m_resolveTimeoutMs);
+    m_socket->connectToHostEncrypted(host, port);
+}
+
+void TcpIoWorker::setState(TcpCommunicator::ConnectionState state)
+{
+    if (m_state == state) {
+        return;
+    }
+
+    qDebug() << "[TCP-IO] 연결 상태 변경:" << TcpCommunicator::connectionStateToString(m_state)
+             << "->" << TcpCommunicator::connectionStateToString(state);
+    m_state = state;
+    emit connectionStateChanged(state);
+}
+
+void TcpIoWorker::onSocketStateChanged(QAbstractSocket::SocketState socketState)
+{
+    // 오류, abort, 정상 종료 모두 UnconnectedState 로 모인다
+    if (socketState == QAbstractSocket::UnconnectedState) {
+        if (m_stageTimer) {
+            m_stageTimer->stop();
+        }
+        m_frameDecoder.reset();
+        resetImageStream();
+        onBytesWritten();
+        setState(TcpCommunicator::ConnectionState::Disconnected);
+    }
+}
+
+void TcpIoWorker::onStageTimeout()
+{
+    const TcpCommunicator::ConnectionState stage = m_state;
+    qDebug() << "[TCP-IO] 연결 단계 타임아웃:" << TcpCommunicator::connectionStateToString(stage);
+
+    if (stage == TcpCommunicator::ConnectionState::Handshaking) {
+        dropSessionTicket();
+    }
+
+    emit stageTimedOut(stage);
+    abortConnection();
+}
+
+void TcpIoWorker::setStageTimeouts(int resolveMs, int connectMs, int handshakeMs)
+{
+    m_resolveTimeoutMs = resolveMs;
+    m_connectTimeoutMs = connectMs;
+    m_handshakeTimeoutMs = handshakeMs;
+}
+
+void TcpIoWorker::setSessionCacheFile(const QString &filePath)
+{
+    m_sessionCache.setStorageFile(filePath);
+}
+
+void TcpIoWorker::storeSessionTicket()
+{
+    if (!m_socket || m_host.isEmpty()) {
+        return;
+    }
+
+    const QSslConfiguration sslConfiguration = m_socket->sslConfiguration();
+    m_sessionCache.store(m_host, m_port, sslConfiguration.sessionTicket(),
+                         sslConfiguration.sessionTicketLifeTimeHint());
+}
+
+void TcpIoWorker::dropSessionTicket()
+{
+    // 티켓을 제시했는데 핸드셰이크가 실패했다면 다음 시도는 전체 핸드셰이크로
+    if (m_offeredTicket) {
+        qDebug() << "[TCP-IO] 세션 재개 실패 - 캐시된 티켓 폐기:" << m_host << ":" << m_port;
+        m_sessionCache.remove(m_host, m_port);
+        m_offeredTicket = false;
+    }
+}
+
+void TcpIoWorker::disconnectFromHost()
+{
+    if (m_socket && m_socket->state() != QAbstractSocket::UnconnectedState) {
+        m_socket->disconnectFromHost();
+    }
+}
+
+void TcpIoWorker::abortConnection()
+{
+    if (m_stageTimer) {
+        m_stageTimer->stop();
+    }
+    if (m_socket) {
+        m_socket->abort();
+    }
+    m_frameDecoder.reset();
+    resetImageStream();
+    setState(TcpCommunicator::ConnectionState::Disconnected);
+}
+
+void TcpIoWorker::shutdown()
+{
+    if (m_socket && m_socket->state() != QAbstractSocket::UnconnectedState) {
+        m_socket->disconnectFromHost();
+        if (m_socket->state() != QAbstractSocket::UnconnectedState) {
+            m_socket->waitForDisconnected(3000);
+        }
+    }
+    setTrafficRecordFile(QString());
+}
+
+void TcpIoWorker::stop()
+{
+    m_stopping = true;
+    QMutexLocker locker(&m_queueMutex);
+    m_queueNotFull.wakeAll();
+}
+
+void TcpIoWorker::setMaxFrameSize(qsizetype maxBytes)
+{
+    m_frameDecoder.setMaxFrameSize(maxBytes);
+}
+
+void TcpIoWorker::submitWrite(const QByteArray &frames, int frameCount)
+{
+    m_postedWriteBytes += frames.size();
+    QMetaObject::invokeMethod(this, [this, frames, frameCount]() {
+        writeBuffer(frames, frameCount);
+    }, Qt::QueuedConnection);
+}
+
+qint64 TcpIoWorker::pendingWriteBytes() const
+{
+    return m_postedWriteBytes.load() + m_socketWriteBytes.load();
+}
+
+void TcpIoWorker::recycleBBoxes(QList<BBox> &&bboxes)
+{
+    // 받는 쪽이 복사본을 들고 있으면 다음 resize 때 어차피 분리되므로 재사용하지 않음
+    if (!bboxes.isDetached() || bboxes.capacity() == 0) {
+        return;
+    }
+    QMutexLocker locker(&m_bboxPoolMutex);
+    if (m_bboxPool.size() < BBoxPoolSize) {
+        m_bboxPool.append(std::move(bboxes));
+    }
+}
+
+void TcpIoWorker::ignoreReply(quint32 seq)
+{
+    QMutexLocker locker(&m_ignoredMutex);
+    // 서버가 끝내 응답하지 않는 경우를 대비해 크기 제한
+    if (m_ignoredReplies.size() >= 4096) {
+        m_ignoredReplies.clear();
+    }
+    m_ignoredReplies.insert(seq);
+}
+
+bool TcpIoWorker::isIgnoredReply(QByteArrayView frame)
+{
+    {
+        QMutexLocker locker(&m_ignoredMutex);
+        if (m_ignoredReplies.isEmpty()) {
+            return false;
+        }
+    }
+
+    // 최상위 seq 만 원시 바이트에서 찾아본다 (이미지 응답 전체를 파싱하지 않기 위함, JSON/CBOR 모두)
+    quint32 seq = 0;
+    if (!PayloadCodec::peekSeq(frame, seq)) {
+        return false;
+    }
+    return isIgnoredSeq(seq);
+}
+
+bool TcpIoWorker::isIgnoredSeq(quint32 seq)
+{
+    if (seq == 0) {
+        return false;
+    }
+    QMutexLocker locker(&m_ignoredMutex);
+    return m_ignoredReplies.remove(seq);
+}
+
+void TcpIoWorker::requestDrainNotification(qint64 lowWaterMark)
+{
+    m_drainLowWaterMark = qMax<qint64>(lowWaterMark, 1);
+}
+
+void TcpIoWorker::writeBuffer(const QByteArray &frames, int frameCount)
+{
+    m_postedWriteBytes -= frames.size();
+
+    if (!m_socket || m_socket->state() != QAbstractSocket::ConnectedState) {
+        qDebug() << "[TCP-IO] 메시지 전송 실패 - 서버에 연결되지 않음 (" << frameCount << "개 프레임 폐기)";
+        onBytesWritten();
+        return;
+    }
+
+    // 길이 헤더와 페이로드가 이미 한 버퍼에 들어 있으므로 write 한 번이면 된다.
+    // flush() 는 호출하지 않고 이벤트 루프가 TLS 레코드로 묶어 내보내게 둔다.
+    const qint64 bytesWritten = m_socket->write(frames);
+    if (bytesWritten == -1) {
+        qDebug() << "[TCP-IO] 메시지 전송 실패:" << m_socket->errorString();
+        return;
+    }
+
+    m_socketWriteBytes = m_socket->bytesToWrite() + m_socket->encryptedBytesToWrite();
+    qDebug() << "[TCP-IO] 메시지 전송 -" << frameCount << "개 프레임," << bytesWritten << "바이트";
+}
+
+void TcpIoWorker::onBytesWritten()
+{
+    m_socketWriteBytes = m_socket ? m_socket->bytesToWrite() + m_socket->encryptedBytesToWrite() : 0;
+
+    const qint64 lowWaterMark = m_drainLowWaterMark.load();
+    if (lowWaterMark > 0 && pendingWriteBytes() <= lowWaterMark) {
+        m_drainLowWaterMark = 0;
+        emit writeDrained();
+    }
+}
+
+void TcpIoWorker::onSocketError(QAbstractSocket::SocketError error)
+{
+    if (m_state == TcpCommunicator::ConnectionState::Handshaking) {
+        dropSessionTicket();
+    }
+    emit socketErrorOccurred(error, m_socket->errorString());
+}
+
+void TcpIoWorker::onSslErrors(const QList<QSslError> &errors)
+{
+    qDebug() << "[TCP-IO] SSL 오류 발생 - 총" << errors.size() << "개의 오류";
+    for (const auto &err : errors) {
+        qDebug() << "[TCP-IO] SSL Error:" << err.errorString();
+    }
+
+    // 개발/테스트 환경에서는 SSL 오류를 무시하여 연결 진행
+    // 프로덕션 환경에서는 적절한 인증서를 설정해야 함
+    qDebug() << "[TCP-IO] SSL 오류 무시하고 연결 계속 진행";
+    m_socket->ignoreSslErrors();
+}
+
+void TcpIoWorker::onReadyRead()
+{
+    // 큰 프레임을 이어 읽는 중이면 프레임이 끝날 때까지 소켓에서 바로 스트림 파서로 넘김
+    if (m_streamRemaining > 0 && !readStreamingFrame()) {
+        return;
+    }
+
+    m_frameDecoder.readFrom(m_socket);
+
+    QByteArrayView frame;
+    while (true) {
+        FrameDecoder::Status status = m_frameDecoder.nextFrame(frame);
+
+        if (status == FrameDecoder::Status::NeedMoreData) {
+            // 큰 프레임(이미지 응답)은 전체를 모으지 않고 도착하는 대로 원소 단위로 처리
+            if (m_frameDecoder.pendingFrameLength() >= StreamingThreshold) {
+                beginStreamingFrame();
+                if (!readStreamingFrame()) {
+                    return;
+                }
+                m_frameDecoder.readFrom(m_socket);
+                continue;
+            }
+            break;
+        }
+
+        if (status == FrameDecoder::Status::FrameTooLarge) {
+            // 길이 헤더가 비정상이면 스트림 동기가 깨진 것이므로 연결을 끊는다
+            InboundMessage message;
+            message.kind = InboundMessage::Kind::Error;
+            message.text = QString("Received frame exceeds maximum size (%1 bytes).")
+                               .arg(m_frameDecoder.pendingFrameLength());
+            enqueue(std::move(message));
+            m_frameDecoder.reset();
+            resetImageStream();
+            m_socket->abort();
+            return;
+        }
+
+        if (m_trafficRecord) {
+            recordFrame(frame);
+        }
+
+        processFrame(frame);
+    }
+}
+
+void TcpIoWorker::processFrame(QByteArrayView frame)
+{
+    // 바이너리 BBox 프레임은 JSON/CBOR 를 거치지 않고 재사용 배열로 바로 디코드
+    if (BBoxFrame::isBBoxFrame(frame)) {
+        InboundMessage message;
+        message.kind = InboundMessage::Kind::BBoxes;
+        message.requestId = 200;
+        // GUI 가 돌려준 배열이 있으면 그 용량에 그대로 디코드 (없을 때만 새로 할당)
+        {
+            QMutexLocker locker(&m_bboxPoolMutex);
+            if (!m_bboxPool.isEmpty()) {
+                message.bboxes = m_bboxPool.takeLast();
+            }
+        }
+        if (!BBoxFrame::decode(frame, message.bboxes, message.timestamp)) {
+            recycleBBoxes(std::move(message.bboxes));
+            message.bboxes = QList<BBox>();
+            message.kind = InboundMessage::Kind::Error;
+            message.text = QString("Malformed binary bbox frame (%1 bytes).").arg(frame.size());
+        }
+        enqueue(std::move(message));
+        return;
+    }
+
+    // 협상 전후 프레임이 섞일 수 있으므로 프레임마다 인코딩을 판별
+    const bool isCbor = PayloadCodec::detect(frame) == PayloadCodec::Encoding::Cbor;
+    if (isIgnoredReply(frame)) {
+        qDebug() << "[TCP-IO] 취소된 요청의 응답 폐기 -" << frame.size() << "바이트";
+        return;
+    }
+
+    QJsonObject jsonObj;
+    QString errorString;
+    if (!PayloadCodec::decode(frame, jsonObj, &errorString)) {
+        qDebug() << "[TCP-IO] Payload parsing error:" << errorString;
+        InboundMessage message;
+        message.kind = InboundMessage::Kind::RawText;
+        message.text = isCbor ? QString("<invalid CBOR payload, %1 bytes>").arg(frame.size())
+                              : QString::fromUtf8(frame.data(), frame.size());
+        enqueue(std::move(message));
+        return;
+    }
+
+    enqueue(parseMessage(jsonObj));
+}
+
+void TcpIoWorker::resetImageStream()
+{
+    m_streamRemaining = 0;
+    m_streamDiscard = false;
+    m_streamSeqChecked = false;
+    m_imageStream.reset();
+    m_streamedImageCount = 0;
+}
+
+void TcpIoWorker::beginStreamingFrame()
+{
+    quint32 frameLength = 0;
+    const QByteArray prefix = m_frameDecoder.takePendingFrame(frameLength);
+
+    resetImageStream();
+    m_streamRemaining = frameLength;
+    qDebug() << "[TCP-IO] 큰 프레임 스트리밍 수신 시작:" << frameLength << "바이트";
+
+    if (m_trafficRecord) {
+        char header[FrameDecoder::HeaderSize];
+        qToBigEndian<quint32>(frameLength, header);
+        m_trafficRecord->write(header, sizeof(header));
+    }
+
+    feedStream(prefix);
+}
+
+bool TcpIoWorker::readStreamingFrame()
+{
+    while (m_streamRemaining > 0) {
+        const qint64 available = m_socket->bytesAvailable();
+        if (available <= 0) {
+            return false;
+        }
+
+        // 프레임 경계를 넘지 않도록 남은 길이만큼만 읽는다
+        const qint64 wanted = qMin<qint64>(qMin(available, m_streamRemaining), StreamingChunkSize);
+        const QByteArray chunk = m_socket->read(wanted);
+        if (chunk.isEmpty()) {
+            return false;
+        }
+        feedStream(chunk);
+    }
+
+    finishStreamingFrame();
+    return true;
+}
+
+void TcpIoWorker::feedStream(QByteArrayView data)
+{
+    m_streamRemaining -= data.size();
+    if (m_trafficRecord) {
+        m_trafficRecord->write(data.data(), data.size());
+    }
+
+    if (m_streamDiscard) {
+        return;
+    }
+
+    const bool ok = m_imageStream.feed(data, [this](const QJsonObject &imageObj) {
+        ImageData imageData;
+        if (!parseImage(imageObj, imageData)) {
+            return;
+        }
+        m_streamedImageCount++;
+
+        // 이미지 하나가 완성될 때마다 바로 GUI 로 넘겨 갤러리가 먼저 채워지게 함
+        InboundMessage message;
+        message.kind = InboundMessage::Kind::ImageStreamItem;
+        message.requestId = 10;
+        message.seq = m_imageStream.seq();
+        message.images.append(imageData);
+        enqueue(std::move(message));
+    });
+
+    if (!ok) {
+        qDebug() << "[TCP-IO] 이미지 응답 스트림 형식 오류 - 나머지 프레임 폐기";
+        m_streamDiscard = true;
+
+        InboundMessage message;
+        message.kind = InboundMessage::Kind::Error;
+        message.requestId = 10;
+        message.seq = m_imageStream.seq();
+        message.text = "Malformed image response.";
+        enqueue(std::move(message));
+        return;
+    }
+
+    // 취소된 요청의 응답이면 seq 를 확인하는 즉시 나머지를 버린다
+    if (!m_streamSeqChecked && m_imageStream.seq() != 0) {
+        m_streamSeqChecked = true;
+        if (isIgnoredSeq(m_imageStream.seq())) {
+            qDebug() << "[TCP-IO] 취소된 요청의 응답 폐기 (스트리밍) - seq:" << m_imageStream.seq();
+            m_streamDiscard = true;
+        }
+    }
+}
+
+void TcpIoWorker::finishStreamingFrame()
+{
+    if (!m_streamDiscard) {
+        if (m_imageStream.isStreaming()) {
+            InboundMessage message;
+            message.kind = InboundMessage::Kind::Images;
+            message.requestId = 10;
+            message.seq = m_imageStream.seq();
+            // 이미지는 ImageStreamItem 으로 이미 모두 보냈으므로 완료만 알림 (요청 핸들에 모여 있음)
+            qDebug() << "[TCP-IO] 이미지 응답 스트리밍 완료 -" << m_streamedImageCount << "개";
+            enqueue(std::move(message));
+        } else {
+            // 스트리밍하지 못한 프레임 (CBOR, data 가 request_id 보다 먼저 온 응답 등) 은 기존 경로로
+            const QByteArray frame = m_imageStream.takeBufferedFrame();
+            processFrame(frame);
+        }
+    }
+
+    resetImageStream();
+}
+
+void TcpIoWorker::setTrafficRecordFile(const QString &filePath)
+{
+    if (m_trafficRecord) {
+        m_trafficRecord->close();
+        delete m_trafficRecord;
+        m_trafficRecord = nullptr;
+    }
+
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    m_trafficRecord = new QFile(filePath);
+    if (!m_trafficRecord->open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qDebug() << "[TCP-IO] 수신 트래픽 기록 파일 열기 실패:" << filePath;
+        delete m_trafficRecord;
+        m_trafficRecord = nullptr;
+        return;
+    }
+    qDebug() << "[TCP-IO] 수신 트래픽 기록:" << filePath;
+}
+
+void TcpIoWorker::recordFrame(QByteArrayView frame)
+{
+    // 소켓과 같은 형식 (4바이트 빅엔디안 길이 + 페이로드) 으로 기록 - 벤치마크 입력으로 사용
+    char header[FrameDecoder::HeaderSize];
+    qToBigEndian<quint32>(static_cast<quint32>(frame.size()), header);
+    m_trafficRecord->write(header, sizeof(header));
+    m_trafficRecord->write(frame.data(), frame.size());
+}
+
+void TcpIoWorker::enqueue(InboundMessage &&message)
+{
+    // 큐 대기 전에 찍어야 GUI 처리 지연이 시계 추정/지연 측정에 섞이지 않는다
+    message.receivedUs = ClockSync::monotonicUs();
+
+    QMutexLocker locker(&m_queueMutex);
+
+    if (m_pendingMessages.size() >= m_queueCapacity) {
+        // BBox 프레임은 최신 것만 의미가 있으므로 가장 오래된 것을 버린다
+        for (int i = 0; i < m_pendingMessages.size(); ++i) {
+            if (m_pendingMessages[i].kind == InboundMessage::Kind::BBoxes) {
+                m_pendingMessages.removeAt(i);
+                break;
+            }
+        }
+    }
+
+    // 버릴 수 없는 메시지만 쌓여 있으면 GUI가 비울 때까지 대기 (소켓 읽기 중단 → TCP 흐름 제어)
+    while (m_pendingMessages.size() >= m_queueCapacity && !m_stopping) {
+        m_queueNotFull.wait(&m_queueMutex, 100);
+    }
+
+    const bool wasEmpty = m_pendingMessages.isEmpty();
+    m_pendingMessages.append(std::move(message));
+    locker.unlock();
+
+    // 큐가 비어 있던 경우에만 깨워서 GUI 이벤트 루프에 알림이 쌓이지 않도록 한다
+    if (wasEmpty) {
+        emit messagesAvailable();
+    }
+}
+
+QList<InboundMessage> TcpIoWorker::takePendingMessages()
+{
+    QMutexLocker locker(&m_queueMutex);
+    QList<InboundMessage> messages;
+    messages.swap(m_pendingMessages);
+    m_queueNotFull.wakeAll();
+    return messages;
+}
+
+InboundMessage TcpIoWorker::parseMessage(const QJsonObject &jsonObj)
+{
+    InboundMessage message;
+
+    // request_id 또는 response_id 확인 (서버 호환성)
+    int requestId = jsonObj["request_id"].toInt();
+    if (requestId == 0) {
+        requestId = jsonObj["response_id"].toInt();
+    }
+    message.requestId = requestId;
+    message.seq = static_cast<quint32>(jsonObj["seq"].toInteger());
+
+    qDebug() << "[TCP-IO] JSON 메시지 수신 - request_id/response_id:" << requestId;
+
+    switch (requestId) {
+    case 10: // 이미지 요청 응답
+    case 41: // 캡처 목록 (메타데이터 + 서버 썸네일)
+    case 43: // 원본 이미지 한 장
+        parseImages(jsonObj, message);
+        break;
+    case 12:
+        message.kind = InboundMessage::Kind::DetectionLines;
+        message.detectionLines = parseDetectionLines(jsonObj);
+        break;
+    case 16:
+        message.kind = InboundMessage::Kind::RoadLines;
+        message.roadLines = parseRoadLines(jsonObj);
+        break;
+    case 200: // BBox 데이터 응답
+        message.kind = InboundMessage::Kind::BBoxes;
+        BBoxFrame::fromJson(jsonObj, message.bboxes, message.timestamp);
+        break;
+    default:
+        message.kind = InboundMessage::Kind::Json;
+        message.json = jsonObj;
+        break;
+    }
+
+    return message;
+}
+
+void TcpIoWorker::parseImages(const QJsonObject &jsonObj, InboundMessage &message)
+{
+    qDebug() << "[TCP-IO] Processing image response...";
+
+    if (!jsonObj.contains("data")) {
+        qDebug() << "[TCP-IO] 'data' field not found in response.";
+        message.kind = InboundMessage::Kind::Error;
+        message.text = "The 'data' field is missing in the server response.";
+        return;
+    }
+
+    message.kind = InboundMessage::Kind::Images;
+
+    // 원본 한 장 응답(43)은 data 가 객체일 수 있음
+    QJsonArray dataArray = jsonObj["data"].isObject() ? QJsonArray{ jsonObj["data"] } : jsonObj["data"].toArray();
+    qDebug() << "[TCP-IO] Size of data array:" << dataArray.size();
+
+    for (int i = 0; i < dataArray.size(); ++i) {
+        QJsonValue value = dataArray[i];
+        if (!value.isObject()) {
+            qDebug() << "[TCP-IO] data[" << i << "] is not an object.";
+            continue;
+        }
+
+        QJsonObject imageObj = value.toObject();
+        ImageData imageData;
+        if (parseImage(imageObj, imageData)) {
+            message.images.append(imageData);
+        }
+    }
+
+    qDebug() << "[TCP-IO] Number of parsed images:" << message.images.size();
+}
+
+bool TcpIoWorker::parseImage(const QJsonObject &imageObj, ImageData &imageData)
+{
+    // 원본은 "image", 목록 응답(41)은 작은 "thumbnail" 만 온다
+    const bool hasImage = imageObj.contains("image");
+    if ((!hasImage && !imageObj.contains("thumbnail")) || !imageObj.contains("timestamp")) {
+        qDebug() << "[TCP-IO] Image object is missing required fields.";
+        return false;
+    }
+
+    imageData.timestamp = imageObj["timestamp"].toString();
+    imageData.logText = QString("Detection time: %1").arg(imageData.timestamp);
+    imageData.detectionType = imageObj["detection_type"].toString("vehicle");
+    imageData.direction = imageObj["direction"].toString("unknown");
+    imageData.lineIndex = imageObj["line_index"].toInt(-1);
+    imageData.thumbnailOnly = !hasImage;
+
+    // data URL 형식이면 "," 앞의 헤더는 버린다
+    const QString base64Image = imageObj[hasImage ? "image" : "thumbnail"].toString();
+    const qsizetype comma = base64Image.lastIndexOf(',');
+    const QStringView base64 = comma >= 0 ? QStringView(base64Image).mid(comma + 1) : QStringView(base64Image);
+
+    // 픽셀 디코드는 하지 않고 헤더만 확인 (갤러리는 썸네일 풀에서 축소 디코드, 원본은 열 때 디코드)
+    imageData.encodedData = QByteArray::fromBase64(base64.toLatin1());
+    if (!ThumbnailCache::canRead(imageData.encodedData)) {
+        qDebug() << "[TCP-IO] Failed to decode image:" << imageData.timestamp;
+        return false;
+    }
+
+    // 캡처 캐시의 파일 이름 (같은 이미지는 카메라/서버가 달라도 한 파일)
+    imageData.contentHash = QCryptographicHash::hash(imageData.encodedData, QCryptographicHash::Sha256);
+    imageData.cameraId = imageObj["camera_id"].toVariant().toString();
+
+    return true;
+}
+
+QList<DetectionLineData> TcpIoWorker::parseDetectionLines(const QJsonObject &jsonObj) const
+{
+    QList<DetectionLineData> detectionLines;
+
+    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
+        QJsonArray dataArray = jsonObj["data"].toArray();
+        for (int i = 0; i < dataArray.size(); ++i) {
+            QJsonObject detectionLineObj = dataArray[i].toObject();
+            DetectionLineData detectionLine;
+            detectionLine.index = detectionLineObj["index"].toInt();
+            detectionLine.x1 = detectionLineObj["x1"].toInt();
+            detectionLine.y1 = detectionLineObj["y1"].toInt();
+            detectionLine.x2 = detectionLineObj["x2"].toInt();
+            detectionLine.y2 = detectionLineObj["y2"].toInt();
+            detectionLine.name = detectionLineObj["name"].toString();
+            detectionLine.mode = detectionLineObj["mode"].toString();
+            // detectionLine.leftMatrixNum = detectionLineObj["leftMatrixNum"].toInt();
+            // detectionLine.rightMatrixNum = detectionLineObj["rightMatrixNum"].toInt();
+            detectionLines.append(detectionLine);
+        }
+    }
+
+    return detectionLines;
+}
+
+QList<RoadLineData> TcpIoWorker::parseRoadLines(const QJsonObject &jsonObj) const
+{
+    QList<RoadLineData> roadLines;
+
+    if (jsonObj.contains("data") && jsonObj["data"].isArray()) {
+        QJsonArray dataArray = jsonObj["data"].toArray();
+        for (int i = 0; i < dataArray.size(); ++i) {
+            QJsonObject roadLineObj = dataArray[i].toObject();
+            RoadLineData roadLine;
+            roadLine.index = roadLineObj["index"].toInt();
+            roadLine.matrixNum1 = roadLineObj["matrixNum1"].toInt();
+            roadLine.x1 = roadLineObj["x1"].toInt();
+            roadLine.y1 = roadLineObj["y1"].toInt();
+            roadLine.matrixNum2 = roadLineObj["matrixNum2"].toInt();
+            roadLine.x2 = roadLineObj["x2"].toInt();
+            roadLine.y2 = roadLineObj["y2"].toInt();
+            roadLines.append(roadLine);
+        }
+    }
+
+    return roadLines;
+}
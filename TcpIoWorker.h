@@ -0,0 +1,176 @@
+#ifndef TCPIOWORKER_H
+#define TCPIOWORKER_H
+
+#include <QObject>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSet>
+#include <QJsonObject>
+#include <QSslSocket>
+#include <QSslError>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <atomic>
+
+#include "TcpCommunicator.h"
+#include "FrameDecoder.h"
+#include "TlsSessionCache.h"
+#include "ImageStreamParser.h"
+
+// I/O 스레드에서 파싱이 끝난 수신 메시지
+struct InboundMessage {
+    enum class Kind {
+        Json,               // 타입이 정해지지 않은 응답 (로그인 등)
+        RawText,            // JSON 파싱 실패
+        Error,              // 응답 형식 오류
+        Images,             // request_id 10
+        DetectionLines,     // request_id 12
+        RoadLines,          // request_id 16
+        BBoxes,             // response_id 200
+        ImageStreamItem     // request_id 10 스트리밍 수신 중 완성된 이미지 하나 (images 에 1개)
+    };
+
+    Kind kind = Kind::Json;
+    int requestId = 0;
+    quint32 seq = 0;        // 요청 상관 id (서버가 돌려준 경우)
+    QJsonObject json;
+    QString text;
+    QList<ImageData> images;
+    QList<DetectionLineData> detectionLines;
+    QList<RoadLineData> roadLines;
+    QList<BBox> bboxes;
+    qint64 timestamp = 0;
+    qint64 receivedUs = 0;  // I/O 스레드가 프레임을 받은 단조 시각 (ClockSync::monotonicUs)
+};
+
+// QSslSocket 을 소유하고 TLS 복호화, 프레이밍, JSON/CBOR 파싱을 전용 스레드에서 수행한다.
+// TcpCommunicator 가 생성하여 I/O 스레드로 옮기며, 슬롯은 모두 queued 호출로만 부른다.
+class TcpIoWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DefaultQueueCapacity = 64;
+    static constexpr qsizetype StreamingThreshold = 1024 * 1024;    // 이 크기 이상 프레임은 스트리밍 수신
+    static constexpr qint64 StreamingChunkSize = 256 * 1024;
+    static constexpr int BBoxPoolSize = 4;                          // 큐에 떠 있는 BBox 프레임 수 정도
+
+    explicit TcpIoWorker(QObject *parent = nullptr);
+    ~TcpIoWorker();
+
+    // GUI 스레드에서 호출 (스레드 안전)
+    QList<InboundMessage> takePendingMessages();
+    void stop();
+
+    // 송신: 여러 프레임을 이어 붙인 버퍼를 I/O 스레드로 넘기고, 아직 전송되지 않은 바이트 수를 조회
+    void submitWrite(const QByteArray &frames, int frameCount);
+    qint64 pendingWriteBytes() const;
+    void requestDrainNotification(qint64 lowWaterMark);
+
+    // 취소/타임아웃된 요청의 응답은 JSON 파싱 전에 버린다
+    void ignoreReply(quint32 seq);
+    // 스레드 안전: GUI 스레드가 다 쓴 BBox 배열을 돌려주면 다음 프레임 디코드에 다시 씀
+    void recycleBBoxes(QList<BBox> &&bboxes);
+
+public slots:
+    void initialize();
+    void connectToHost(const QString &host, quint16 port);
+    void disconnectFromHost();
+    void abortConnection();
+    void shutdown();
+    void writeBuffer(const QByteArray &frames, int frameCount);
+    void setMaxFrameSize(qsizetype maxBytes);
+    void setStageTimeouts(int resolveMs, int connectMs, int handshakeMs);
+    void setSessionCacheFile(const QString &filePath);
+    void setTrafficRecordFile(const QString &filePath);   // 빈 경로면 기록 중지
+
+signals:
+    void connectionStateChanged(TcpCommunicator::ConnectionState state);
+    void stageTimedOut(TcpCommunicator::ConnectionState stage);
+    void handshakeCompleted(qint64 elapsedMs, bool resumed);
+    void writeDrained();
+    void socketErrorOccurred(QAbstractSocket::SocketError error, const QString &errorString);
+    void messagesAvailable();
+
+private slots:
+    void onReadyRead();
+    void onSocketError(QAbstractSocket::SocketError error);
+    void onSocketStateChanged(QAbstractSocket::SocketState socketState);
+    void onSslErrors(const QList<QSslError> &errors);
+    void onStageTimeout();
+    void onBytesWritten();
+
+private:
+    void setupSslConfiguration();
+    void setState(TcpCommunicator::ConnectionState state);
+    void storeSessionTicket();
+    void dropSessionTicket();
+    void enqueue(InboundMessage &&message);
+    void processFrame(QByteArrayView frame);
+
+    // 큰 프레임 스트리밍 수신 (이미지 응답을 원소 단위로 파싱)
+    void beginStreamingFrame();
+    bool readStreamingFrame();      // 프레임을 끝까지 읽었으면 true
+    void feedStream(QByteArrayView data);
+    void finishStreamingFrame();
+    void resetImageStream();
+    InboundMessage parseMessage(const QJsonObject &jsonObj);
+    bool isIgnoredReply(QByteArrayView frame);
+    bool isIgnoredSeq(quint32 seq);
+    void recordFrame(QByteArrayView frame);
+
+    // request_id 별 파싱
+    void parseImages(const QJsonObject &jsonObj, InboundMessage &message);
+    bool parseImage(const QJsonObject &imageObj, ImageData &imageData);
+    QList<DetectionLineData> parseDetectionLines(const QJsonObject &jsonObj) const;
+    QList<RoadLineData> parseRoadLines(const QJsonObject &jsonObj) const;
+
+    QSslSocket *m_socket;
+    FrameDecoder m_frameDecoder;
+
+    // 스트리밍 수신 중인 프레임 (남은 바이트가 0 이면 일반 프레이밍)
+    ImageStreamParser m_imageStream;
+    qint64 m_streamRemaining;
+    bool m_streamDiscard;           // 취소된 요청이거나 형식 오류 - 남은 바이트는 읽고 버림
+    bool m_streamSeqChecked;
+    int m_streamedImageCount;       // 이미 ImageStreamItem 으로 보낸 이미지 수
+
+    // 연결 상태 머신 (resolve → TCP connect → TLS handshake → ready)
+    TcpCommunicator::ConnectionState m_state;
+    QTimer *m_stageTimer;
+    int m_resolveTimeoutMs;
+    int m_connectTimeoutMs;
+    int m_handshakeTimeoutMs;
+
+    // TLS 세션 재개 (티켓 캐시 + 핸드셰이크 시간 측정)
+    TlsSessionCache m_sessionCache;
+    QString m_host;
+    quint16 m_port;
+    bool m_offeredTicket;
+    QElapsedTimer m_handshakeTimer;
+
+    // 수신 프레임 기록 (페이로드 인코딩 벤치마크용, 기본 꺼짐)
+    QFile *m_trafficRecord;
+
+    // 송신 대기 바이트 (GUI 스레드가 backpressure 판단에 사용)
+    std::atomic<qint64> m_postedWriteBytes;     // I/O 스레드로 넘겼지만 아직 소켓에 쓰지 않은 바이트
+    std::atomic<qint64> m_socketWriteBytes;     // 소켓 송신 버퍼에 남은 바이트
+    std::atomic<qint64> m_drainLowWaterMark;    // 0 이면 알림 요청 없음
+
+    // 더 이상 기다리지 않는 응답의 seq (GUI 스레드에서 추가)
+    QMutex m_ignoredMutex;
+    QMutex m_bboxPoolMutex;
+    QList<QList<BBox>> m_bboxPool;  // 돌려받은 BBox 배열 - 큐를 거쳐 도는 몇 개를 계속 재사용
+    QSet<quint32> m_ignoredReplies;
+
+    // 수신 메시지 큐 (I/O 스레드 → GUI 스레드)
+    QMutex m_queueMutex;
+    QWaitCondition m_queueNotFull;
+    QList<InboundMessage> m_pendingMessages;
+    int m_queueCapacity;
+    std::atomic_bool m_stopping;
+};
+
+#endif // TCPIOWORKER_H
@@ -0,0 +1,113 @@
+#include "ThumbnailCache.h"
+#include <QBuffer>
+#include <QDebug>
+#include <QImageReader>
+#include <QPointer>
+#include <QThread>
+
+ThumbnailCache::ThumbnailCache(const QSize &thumbnailSize, qint64 budgetBytes, QObject *parent)
+    : QObject(parent)
+    , m_thumbnailSize(thumbnailSize)
+{
+    // I/O 스레드와 GUI 스레드 몫은 남겨 둔다
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 2));
+    m_pixmaps.setMaxCost(budgetBytes);
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QByteArray ThumbnailCache::keyFor(const ImageData &image)
+{
+    if (!image.contentHash.isEmpty()) {
+        return image.contentHash;
+    }
+    return (image.cameraId + QChar('|') + image.timestamp).toUtf8();
+}
+
+QPixmap ThumbnailCache::thumbnail(const ImageData &image)
+{
+    const QByteArray key = keyFor(image);
+    if (QPixmap *cached = m_pixmaps.object(key)) {
+        return *cached;
+    }
+
+    if (image.encodedData.isEmpty() || m_inFlight.contains(key)) {
+        return QPixmap();
+    }
+    m_inFlight.insert(key);
+
+    QPointer<ThumbnailCache> self(this);
+    const QByteArray encodedData = image.encodedData;
+    const QSize size = m_thumbnailSize;
+    m_pool.start([self, key, encodedData, size]() {
+        const QImage thumbnail = readImage(encodedData, size);
+        QMetaObject::invokeMethod(self, [self, key, thumbnail]() {
+            if (self) {
+                self->onDecoded(key, thumbnail);
+            }
+        }, Qt::QueuedConnection);
+    });
+
+    return QPixmap();
+}
+
+void ThumbnailCache::onDecoded(const QByteArray &key, const QImage &image)
+{
+    m_inFlight.remove(key);
+
+    if (image.isNull()) {
+        qDebug() << "[Thumbnail] 디코드 실패:" << key.toHex().left(16);
+        emit thumbnailReady(key, QPixmap());
+        return;
+    }
+
+    // QPixmap 변환은 GUI 스레드에서만 가능
+    const QPixmap pixmap = QPixmap::fromImage(image);
+    const qsizetype cost = qsizetype(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    m_pixmaps.insert(key, new QPixmap(pixmap), cost);
+
+    emit thumbnailReady(key, pixmap);
+}
+
+void ThumbnailCache::cancelPending()
+{
+    // 실행 중인 디코드는 끝까지 돌고 결과는 캐시에 들어간다
+    m_pool.clear();
+    m_inFlight.clear();
+}
+
+void ThumbnailCache::setBudget(qint64 budgetBytes)
+{
+    m_pixmaps.setMaxCost(budgetBytes);
+}
+
+QImage ThumbnailCache::readImage(const QByteArray &encodedData, const QSize &boundingSize)
+{
+    QBuffer buffer;
+    buffer.setData(encodedData);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    if (boundingSize.isValid()) {
+        const QSize sourceSize = reader.size();
+        if (sourceSize.isValid() && (sourceSize.width() > boundingSize.width() ||
+                                     sourceSize.height() > boundingSize.height())) {
+            reader.setScaledSize(sourceSize.scaled(boundingSize, Qt::KeepAspectRatio));
+        }
+    }
+    return reader.read();
+}
+
+bool ThumbnailCache::canRead(const QByteArray &encodedData)
+{
+    QBuffer buffer;
+    buffer.setData(encodedData);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    return reader.canRead() && reader.size().isValid();
+}
@@ -0,0 +1,55 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QThreadPool>
+
+#include "TcpCommunicator.h"
+
+// 갤러리 썸네일 디코드 풀 + 메모리 한도가 있는 LRU 픽스맵 캐시 (GUI 스레드)
+// 원본(encodedData)을 QImageReader::setScaledSize 로 썸네일 크기로 바로 디코드하므로
+// JPEG 은 디코더 단계에서 축소되고 전체 해상도 이미지는 메모리에 올라오지 않는다.
+class ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    ThumbnailCache(const QSize &thumbnailSize, qint64 budgetBytes, QObject *parent = nullptr);
+    ~ThumbnailCache();
+
+    static QByteArray keyFor(const ImageData &image);
+
+    // 캐시에 있으면 바로 돌려주고, 없으면 디코드를 예약한 뒤 null (끝나면 thumbnailReady)
+    QPixmap thumbnail(const ImageData &image);
+
+    // 아직 시작하지 않은 디코드를 버린다 (갤러리를 새 조회 결과로 바꿀 때)
+    void cancelPending();
+
+    void setBudget(qint64 budgetBytes);
+    qint64 usedBytes() const { return m_pixmaps.totalCost(); }
+    qint64 budgetBytes() const { return m_pixmaps.maxCost(); }
+
+    // boundingSize 가 있으면 비율을 유지해 그 안에 들어가는 크기로 디코드
+    static QImage readImage(const QByteArray &encodedData, const QSize &boundingSize = QSize());
+    // 헤더만 읽어 디코드 가능한지 확인 (픽셀 디코드 없음)
+    static bool canRead(const QByteArray &encodedData);
+
+signals:
+    void thumbnailReady(const QByteArray &key, const QPixmap &pixmap);
+
+private:
+    void onDecoded(const QByteArray &key, const QImage &image);
+
+    QThreadPool m_pool;
+    QCache<QByteArray, QPixmap> m_pixmaps;  // 비용 = 픽스맵 바이트 수
+    QSet<QByteArray> m_inFlight;
+    QSize m_thumbnailSize;
+};
+
+#endif // THUMBNAILCACHE_H
@@ -0,0 +1,356 @@
+#include "TiledImageView.h"
+#include "ThumbnailCache.h"
+#include <QBuffer>
+#include <QImageReader>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPointer>
+#include <QWheelEvent>
+#include <cmath>
+
+namespace {
+const int kTileSize = 256;
+const double kMaxScale = 8.0;                       // 원본 1픽셀 = 화면 8픽셀까지
+const double kZoomStep = 1.25;
+const qint64 kTileBudgetBytes = 48 * 1024 * 1024;   // 48MB
+const QColor kBackgroundColor("#2e2e3a");
+
+quint64 tileKey(int level, int column, int row)
+{
+    return (quint64(level) << 48) | (quint64(row) << 24) | quint64(column);
+}
+}
+
+TiledImageView::TiledImageView(QWidget *parent)
+    : QWidget(parent)
+    , m_generation(0)
+    , m_loading(false)
+    , m_failed(false)
+    , m_scale(1.0)
+    , m_fitted(true)
+    , m_dragging(false)
+{
+    // 빌드는 한 번에 하나면 충분 (새 이미지가 오면 이전 결과는 버림)
+    m_pool.setMaxThreadCount(1);
+    m_tiles.setMaxCost(kTileBudgetBytes);
+
+    setFocusPolicy(Qt::StrongFocus);
+    setCursor(Qt::OpenHandCursor);
+    setMinimumSize(320, 180);
+}
+
+TiledImageView::~TiledImageView()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void TiledImageView::setImage(const QImage &image)
+{
+    clear();
+    m_imageSize = image.size();
+    fitToView();
+    startBuild(image, QByteArray());
+}
+
+void TiledImageView::setEncodedImage(const QByteArray &encodedData)
+{
+    clear();
+
+    // 크기는 헤더에서 미리 알아 두고 창 배치/배율을 먼저 잡는다
+    QBuffer buffer;
+    buffer.setData(encodedData);
+    QImageReader reader(&buffer);
+    m_imageSize = reader.size();
+    fitToView();
+    startBuild(QImage(), encodedData);
+}
+
+void TiledImageView::clear()
+{
+    ++m_generation;
+    m_pool.clear();
+    m_levels.clear();
+    m_tiles.clear();
+    m_imageSize = QSize();
+    m_loading = false;
+    m_failed = false;
+    m_dragging = false;
+    update();
+}
+
+QList<QImage> TiledImageView::buildPyramid(const QImage &image)
+{
+    QList<QImage> levels;
+    if (image.isNull()) {
+        return levels;
+    }
+
+    // 그리기 빠른 형식으로 한 번만 변환
+    levels.append(image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                                : QImage::Format_RGB32));
+    // 타일 한 장에 들어갈 때까지 이전 단계를 반으로 (원본을 매번 다시 줄이지 않음)
+    while (qMax(levels.last().width(), levels.last().height()) > kTileSize) {
+        const QImage &previous = levels.last();
+        QImage half = previous.scaled(qMax(1, previous.width() / 2), qMax(1, previous.height() / 2),
+                                      Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        levels.append(half);
+    }
+    return levels;
+}
+
+void TiledImageView::startBuild(const QImage &image, const QByteArray &encodedData)
+{
+    m_loading = true;
+
+    QPointer<TiledImageView> self(this);
+    const quint64 generation = m_generation;
+    m_pool.start([self, generation, image, encodedData]() {
+        const QImage full = image.isNull() ? ThumbnailCache::readImage(encodedData) : image;
+        const QList<QImage> levels = buildPyramid(full);
+        QMetaObject::invokeMethod(self, [self, generation, levels]() {
+            if (self) {
+                self->onPyramidReady(generation, levels);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void TiledImageView::onPyramidReady(quint64 generation, const QList<QImage> &levels)
+{
+    if (generation != m_generation) {
+        return;
+    }
+
+    m_loading = false;
+    if (levels.isEmpty()) {
+        m_failed = true;
+        update();
+        return;
+    }
+
+    m_levels = levels;
+    if (m_imageSize != m_levels.first().size()) {
+        m_imageSize = m_levels.first().size();
+        m_fitted = true;
+    }
+    if (m_fitted) {
+        fitToView();
+    } else {
+        clampCenter();
+    }
+    update();
+}
+
+double TiledImageView::fitScale() const
+{
+    if (m_imageSize.isEmpty() || width() <= 0 || height() <= 0) {
+        return 1.0;
+    }
+    // 작은 이미지는 확대하지 않고 원본 크기로 맞춤
+    return qMin(1.0, qMin(double(width()) / m_imageSize.width(), double(height()) / m_imageSize.height()));
+}
+
+void TiledImageView::fitToView()
+{
+    m_scale = fitScale();
+    m_center = QPointF(m_imageSize.width() / 2.0, m_imageSize.height() / 2.0);
+    m_fitted = true;
+    update();
+    emit scaleChanged(m_scale);
+}
+
+void TiledImageView::zoomBy(double factor)
+{
+    setScale(m_scale * factor, QPointF(width() / 2.0, height() / 2.0));
+}
+
+void TiledImageView::setScale(double scale, const QPointF &anchor)
+{
+    if (m_imageSize.isEmpty()) {
+        return;
+    }
+
+    scale = qBound(fitScale(), scale, kMaxScale);
+
+    // anchor(화면 좌표) 아래의 원본 위치가 그대로 남도록 가운데를 옮김
+    const QPointF viewCenter(width() / 2.0, height() / 2.0);
+    const QPointF imagePoint = m_center + (anchor - viewCenter) / m_scale;
+    m_scale = scale;
+    m_center = imagePoint - (anchor - viewCenter) / m_scale;
+    m_fitted = qFuzzyCompare(m_scale, fitScale());
+
+    clampCenter();
+    update();
+    emit scaleChanged(m_scale);
+}
+
+void TiledImageView::clampCenter()
+{
+    const double halfWidth = width() / 2.0 / m_scale;
+    const double halfHeight = height() / 2.0 / m_scale;
+
+    // 화면보다 작은 축은 가운데 정렬, 큰 축은 이미지 밖으로 나가지 않게
+    m_center.setX(m_imageSize.width() <= 2 * halfWidth
+                      ? m_imageSize.width() / 2.0
+                      : qBound(halfWidth, m_center.x(), m_imageSize.width() - halfWidth));
+    m_center.setY(m_imageSize.height() <= 2 * halfHeight
+                      ? m_imageSize.height() / 2.0
+                      : qBound(halfHeight, m_center.y(), m_imageSize.height() - halfHeight));
+}
+
+int TiledImageView::levelFor(double scale) const
+{
+    // 배율 이상인 단계 중 가장 작은 것 (그릴 때 최대 2배까지만 축소)
+    const int level = scale >= 1.0 ? 0 : int(std::floor(std::log2(1.0 / scale)));
+    return qBound(0, level, int(m_levels.size()) - 1);
+}
+
+QPixmap TiledImageView::tile(int level, int column, int row)
+{
+    const quint64 key = tileKey(level, column, row);
+    if (QPixmap *cached = m_tiles.object(key)) {
+        return *cached;
+    }
+
+    const QImage &image = m_levels.at(level);
+    const QRect rect = QRect(column * kTileSize, row * kTileSize, kTileSize, kTileSize) & image.rect();
+    const QPixmap pixmap = QPixmap::fromImage(image.copy(rect));
+    const qsizetype cost = qsizetype(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    m_tiles.insert(key, new QPixmap(pixmap), cost);
+    return pixmap;
+}
+
+void TiledImageView::paintEvent(QPaintEvent * /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), kBackgroundColor);
+
+    if (m_levels.isEmpty()) {
+        if (m_loading || m_failed) {
+            painter.setPen(m_failed ? QColor("#999999") : Qt::white);
+            painter.drawText(rect(), Qt::AlignCenter, m_failed ? "이미지를 불러올 수 없습니다." : "이미지 불러오는 중...");
+        }
+        return;
+    }
+
+    const int level = levelFor(m_scale);
+    const QImage &image = m_levels.at(level);
+    const double levelFactor = double(image.width()) / m_imageSize.width();
+    const double paintScale = m_scale / levelFactor;            // 화면 픽셀 / 단계 픽셀
+    const QPointF levelCenter = m_center * levelFactor;
+    const QPointF viewCenter(width() / 2.0, height() / 2.0);
+
+    // 2배 이상 확대하면 픽셀을 그대로 보여줌 (작은 대상 확인용)
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, paintScale < 2.0);
+
+    // 화면에 보이는 단계 좌표 범위의 타일만
+    const double left = levelCenter.x() - viewCenter.x() / paintScale;
+    const double top = levelCenter.y() - viewCenter.y() / paintScale;
+    const double right = levelCenter.x() + viewCenter.x() / paintScale;
+    const double bottom = levelCenter.y() + viewCenter.y() / paintScale;
+
+    const int columns = (image.width() + kTileSize - 1) / kTileSize;
+    const int rows = (image.height() + kTileSize - 1) / kTileSize;
+    const int firstColumn = qMax(0, int(std::floor(left / kTileSize)));
+    const int lastColumn = qMin(columns - 1, int(std::floor(right / kTileSize)));
+    const int firstRow = qMax(0, int(std::floor(top / kTileSize)));
+    const int lastRow = qMin(rows - 1, int(std::floor(bottom / kTileSize)));
+
+    auto toView = [&](double levelX, double levelY) {
+        return QPoint(qRound((levelX - levelCenter.x()) * paintScale + viewCenter.x()),
+                      qRound((levelY - levelCenter.y()) * paintScale + viewCenter.y()));
+    };
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const QPixmap pixmap = tile(level, column, row);
+            const double x = column * kTileSize;
+            const double y = row * kTileSize;
+            // 타일 경계를 정수로 맞춰 이음새가 보이지 않게
+            const QPoint topLeft = toView(x, y);
+            const QPoint bottomRight = toView(x + pixmap.width(), y + pixmap.height());
+            painter.drawPixmap(QRect(topLeft, bottomRight - QPoint(1, 1)), pixmap);
+        }
+    }
+}
+
+void TiledImageView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    if (m_fitted) {
+        fitToView();
+    } else {
+        clampCenter();
+    }
+}
+
+void TiledImageView::wheelEvent(QWheelEvent *event)
+{
+    const double steps = event->angleDelta().y() / 120.0;
+    if (steps != 0.0) {
+        setScale(m_scale * std::pow(kZoomStep, steps), event->position());
+    }
+    event->accept();
+}
+
+void TiledImageView::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = true;
+        m_lastDragPos = event->pos();
+        setCursor(Qt::ClosedHandCursor);
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void TiledImageView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_dragging) {
+        const QPoint delta = event->pos() - m_lastDragPos;
+        m_lastDragPos = event->pos();
+        m_center -= QPointF(delta) / m_scale;
+        clampCenter();
+        update();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void TiledImageView::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = false;
+        setCursor(Qt::OpenHandCursor);
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void TiledImageView::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    // 맞춤 <-> 원본 크기(100%) 전환
+    if (m_fitted) {
+        setScale(1.0, event->position());
+    } else {
+        fitToView();
+    }
+}
+
+void TiledImageView::keyPressEvent(QKeyEvent *event)
+{
+    switch (event->key()) {
+    case Qt::Key_Plus:
+    case Qt::Key_Equal:
+        zoomBy(kZoomStep);
+        break;
+    case Qt::Key_Minus:
+        zoomBy(1.0 / kZoomStep);
+        break;
+    case Qt::Key_0:
+        fitToView();
+        break;
+    default:
+        QWidget::keyPressEvent(event);
+        break;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef TILEDIMAGEVIEW_H
+#define TILEDIMAGEVIEW_H
+
+#include <QWidget>
+#include <QByteArray>
+#include <QCache>
+#include <QImage>
+#include <QList>
+#include <QPixmap>
+#include <QPointF>
+#include <QThreadPool>
+
+// 확대/이동 가능한 원본 이미지 뷰
+// 작업 스레드에서 원본을 디코드하고 1/2 씩 줄인 밉맵 피라미드를 한 번만 만든 뒤,
+// 그리기는 현재 배율에 맞는 단계에서 화면에 보이는 타일(256x256)만 픽스맵으로 올려 그린다.
+// 확대/축소 중에는 원본을 다시 축소하지 않는다.
+class TiledImageView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TiledImageView(QWidget *parent = nullptr);
+    ~TiledImageView();
+
+    void setImage(const QImage &image);
+    // 디코드까지 작업 스레드에서 (GUI 스레드에서는 헤더만 읽음)
+    void setEncodedImage(const QByteArray &encodedData);
+    void clear();
+
+    QSize imageSize() const { return m_imageSize; }
+    double scale() const { return m_scale; }
+
+public slots:
+    void fitToView();
+    void zoomBy(double factor);
+
+signals:
+    void scaleChanged(double scale);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+
+private:
+    static QList<QImage> buildPyramid(const QImage &image);
+    void startBuild(const QImage &image, const QByteArray &encodedData);
+    void onPyramidReady(quint64 generation, const QList<QImage> &levels);
+
+    double fitScale() const;
+    void setScale(double scale, const QPointF &anchor);
+    void clampCenter();
+    int levelFor(double scale) const;
+    QPixmap tile(int level, int column, int row);
+
+    QThreadPool m_pool;
+    quint64 m_generation;                   // 새 이미지가 오면 늦게 끝난 이전 빌드를 버림
+    QList<QImage> m_levels;                 // [0] = 원본, [n] = 1/2^n
+    QCache<quint64, QPixmap> m_tiles;       // 비용 = 픽스맵 바이트 수
+    QSize m_imageSize;
+    bool m_loading;
+    bool m_failed;
+
+    double m_scale;                         // 화면 픽셀 / 원본 픽셀
+    bool m_fitted;                          // 창 크기가 바뀌면 다시 맞춤
+    QPointF m_center;                       // 화면 가운데에 오는 원본 좌표
+    QPoint m_lastDragPos;
+    bool m_dragging;
+};
+
+#endif // TILEDIMAGEVIEW_H
@@ -0,0 +1,135 @@
+#include "TlsSessionCache.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+namespace {
+const qint64 kDefaultLifetimeMs = 24LL * 60 * 60 * 1000;   // 수명 힌트가 없을 때 24시간
+}
+
+TlsSessionCache::TlsSessionCache()
+{
+}
+
+QString TlsSessionCache::key(const QString &host, quint16 port)
+{
+    return host + ":" + QString::number(port);
+}
+
+bool TlsSessionCache::isExpired(const Entry &entry) const
+{
+    return entry.expiresAtMs > 0 && QDateTime::currentMSecsSinceEpoch() >= entry.expiresAtMs;
+}
+
+void TlsSessionCache::setStorageFile(const QString &filePath)
+{
+    if (m_filePath == filePath) {
+        return;
+    }
+
+    m_filePath = filePath;
+    if (!m_filePath.isEmpty()) {
+        load();
+    }
+}
+
+QByteArray TlsSessionCache::ticket(const QString &host, quint16 port) const
+{
+    auto it = m_entries.constFind(key(host, port));
+    if (it == m_entries.constEnd() || isExpired(it.value())) {
+        return QByteArray();
+    }
+    return it.value().ticket;
+}
+
+void TlsSessionCache::store(const QString &host, quint16 port, const QByteArray &ticket, int lifetimeHintSecs)
+{
+    if (ticket.isEmpty()) {
+        return;
+    }
+
+    Entry entry;
+    entry.ticket = ticket;
+    entry.expiresAtMs = QDateTime::currentMSecsSinceEpoch() +
+                        (lifetimeHintSecs > 0 ? lifetimeHintSecs * 1000LL : kDefaultLifetimeMs);
+
+    const QString entryKey = key(host, port);
+    auto it = m_entries.constFind(entryKey);
+    if (it != m_entries.constEnd() && it.value().ticket == ticket) {
+        return;
+    }
+
+    m_entries.insert(entryKey, entry);
+    save();
+}
+
+void TlsSessionCache::remove(const QString &host, quint16 port)
+{
+    if (m_entries.remove(key(host, port)) > 0) {
+        save();
+    }
+}
+
+void TlsSessionCache::clear()
+{
+    m_entries.clear();
+    save();
+}
+
+void TlsSessionCache::load()
+{
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = root.constBegin(); it != root.constEnd(); ++it) {
+        const QJsonObject obj = it.value().toObject();
+
+        Entry entry;
+        entry.ticket = QByteArray::fromBase64(obj["ticket"].toString().toLatin1());
+        entry.expiresAtMs = static_cast<qint64>(obj["expires_at"].toDouble());
+
+        if (!entry.ticket.isEmpty() && !isExpired(entry)) {
+            m_entries.insert(it.key(), entry);
+        }
+    }
+
+    qDebug() << "[TLS] 세션 티켓 캐시 로드:" << m_entries.size() << "개 -" << m_filePath;
+}
+
+void TlsSessionCache::save() const
+{
+    if (m_filePath.isEmpty()) {
+        return;
+    }
+
+    QJsonObject root;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        if (isExpired(it.value())) {
+            continue;
+        }
+        QJsonObject obj;
+        obj["ticket"] = QString::fromLatin1(it.value().ticket.toBase64());
+        obj["expires_at"] = static_cast<double>(it.value().expiresAtMs);
+        root[it.key()] = obj;
+    }
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+
+    // 세션 티켓은 비밀 값이므로 소유자만 읽을 수 있게 저장
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "[TLS] 세션 티켓 캐시 저장 실패:" << m_filePath;
+        return;
+    }
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
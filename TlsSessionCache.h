@@ -0,0 +1,41 @@
+#ifndef TLSSESSIONCACHE_H
+#define TLSSESSIONCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+// TLS 세션 티켓 캐시 (host:port 별)
+// 재연결 시 티켓을 제시해 전체 핸드셰이크 대신 세션 재개(resumption)를 시도한다.
+// 파일 경로를 지정하면 티켓을 디스크에 보관해 앱을 재시작해도 재개할 수 있다.
+// I/O 스레드(TcpIoWorker)에서만 사용한다.
+class TlsSessionCache
+{
+public:
+    TlsSessionCache();
+
+    // 빈 경로면 메모리에만 보관
+    void setStorageFile(const QString &filePath);
+    QString storageFile() const { return m_filePath; }
+
+    QByteArray ticket(const QString &host, quint16 port) const;
+    void store(const QString &host, quint16 port, const QByteArray &ticket, int lifetimeHintSecs);
+    void remove(const QString &host, quint16 port);
+    void clear();
+
+private:
+    struct Entry {
+        QByteArray ticket;
+        qint64 expiresAtMs = 0;     // 0 이면 서버가 수명 힌트를 주지 않음
+    };
+
+    static QString key(const QString &host, quint16 port);
+    bool isExpired(const Entry &entry) const;
+    void load();
+    void save() const;
+
+    QHash<QString, Entry> m_entries;
+    QString m_filePath;
+};
+
+#endif // TLSSESSIONCACHE_H
@@ -1,5 +1,7 @@
 #include "VideoStreamWidget.h"
 #include "custommessagebox.h"
+#include "ReconnectScheduler.h"
+#include "EnvConfig.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QApplication>
@@ -14,29 +16,40 @@ VideoStreamWidget::VideoStreamWidget(QWidget *parent)
     , m_videoWidget(nullptr)
     , m_statusLabel(nullptr)
     , m_liveIndicator(nullptr)
+    , m_delayLabel(nullptr)
     , m_layout(nullptr)
-    , m_mediaPlayer(nullptr)
-    , m_audioOutput(nullptr)
+    , m_streamSource(nullptr)
     , m_connectionTimer(nullptr)
     , m_liveBlinkTimer(nullptr)
     , m_statusUpdateTimer(nullptr)
+    , m_reconnectScheduler(new ReconnectScheduler(this))
     , m_isStreaming(false)
-    , m_reconnectAttempts(0)
 {
+    // 저지연 재생: 버퍼를 최소로 두고 늦은 프레임은 버림 (LIVE_LOW_LATENCY=false 면 QMediaPlayer 기본 버퍼링)
+    m_liveOptions.lowLatency = EnvConfig::getBoolValue("LIVE_LOW_LATENCY", true);
+    m_liveOptions.transport = RtspStreamSource::transportFromName(EnvConfig::getValue("RTSP_TRANSPORT", "auto"));
+    m_liveOptions.targetDelayMs = EnvConfig::getIntValue("LIVE_TARGET_DELAY_MS", 150);
+    m_liveOptions.maxDelayMs = EnvConfig::getIntValue("LIVE_MAX_DELAY_MS", 600);
+    m_liveOptions.catchUpPercent = qBound(100, EnvConfig::getIntValue("LIVE_CATCHUP_PERCENT", 110), 200);
+
     setupUI();
-    setupMediaPlayer();
     setupTimers();
+
+    connect(m_reconnectScheduler, &ReconnectScheduler::reconnectScheduled, this, [this](int attempt, int delayMs) {
+        const QString progress = m_reconnectScheduler->neverGiveUp()
+            ? QString::number(attempt)
+            : QString("%1/%2").arg(attempt).arg(m_reconnectScheduler->maxAttempts());
+        showConnectionStatus(QString("재연결 대기 중... (%1, %2초 후)").arg(progress).arg(delayMs / 1000.0, 0, 'f', 1), "#ff9800");
+    });
+    connect(m_reconnectScheduler, &ReconnectScheduler::reconnectRequested,
+            this, &VideoStreamWidget::onReconnectRequested);
+    connect(m_reconnectScheduler, &ReconnectScheduler::gaveUp,
+            this, &VideoStreamWidget::onReconnectGaveUp);
 }
 
 VideoStreamWidget::~VideoStreamWidget()
 {
     stopStream();
-    if (m_mediaPlayer) {
-        delete m_mediaPlayer;
-    }
-    if (m_audioOutput) {
-        delete m_audioOutput;
-    }
 }
 
 void VideoStreamWidget::setupUI()
@@ -67,6 +80,12 @@ void VideoStreamWidget::setupUI()
 
     statusLayout->addStretch();
 
+    // 쌓인 재생 지연 (가장 빨리 나온 프레임 기준)
+    m_delayLabel = new QLabel();
+    m_delayLabel->setToolTip("가장 빨리 표시된 프레임보다 늦어진 재생 지연 (버퍼에 쌓인 시간)");
+    m_delayLabel->setVisible(false);
+    statusLayout->addWidget(m_delayLabel);
+
     // draw 버튼 추가
     QPushButton *drawButton = new QPushButton();
     drawButton->setIcon(QIcon(":/icons/draw.png"));  // 아이콘 경로 확인
@@ -93,21 +112,39 @@ void VideoStreamWidget::setupUI()
 }
 
 
-void VideoStreamWidget::setupMediaPlayer()
+void VideoStreamWidget::attachSource()
 {
-    m_mediaPlayer = new QMediaPlayer(this);
-    m_audioOutput = new QAudioOutput(this);
-    
-    m_mediaPlayer->setAudioOutput(m_audioOutput);
-    m_mediaPlayer->setVideoOutput(m_videoWidget);
-    
+    m_streamSource = RtspStreamSource::forUrl(m_rtspUrl);
+    m_streamSource->setLiveOptions(m_liveOptions);
+    QMediaPlayer *player = m_streamSource->player();
+
     // 미디어 플레이어 시그널 연결
-    connect(m_mediaPlayer, &QMediaPlayer::mediaStatusChanged,
+    connect(player, &QMediaPlayer::mediaStatusChanged,
             this, &VideoStreamWidget::onMediaStatusChanged);
-    connect(m_mediaPlayer, &QMediaPlayer::playbackStateChanged,
+    connect(player, &QMediaPlayer::playbackStateChanged,
             this, &VideoStreamWidget::onPlaybackStateChanged);
-    connect(m_mediaPlayer, &QMediaPlayer::errorOccurred,
+    connect(player, &QMediaPlayer::errorOccurred,
             this, &VideoStreamWidget::onErrorOccurred);
+    connect(m_streamSource, &RtspStreamSource::playbackDelayChanged,
+            this, &VideoStreamWidget::onPlaybackDelayChanged);
+
+    m_streamSource->attach(m_videoWidget->videoSink());
+
+    // 다른 화면이 이미 재생 중인 세션이면 상태 변화가 오지 않으므로 바로 반영
+    if (player->mediaStatus() == QMediaPlayer::BufferedMedia) {
+        onMediaStatusChanged(QMediaPlayer::BufferedMedia);
+    }
+}
+
+void VideoStreamWidget::detachSource()
+{
+    if (!m_streamSource) {
+        return;
+    }
+    disconnect(m_streamSource->player(), nullptr, this, nullptr);
+    disconnect(m_streamSource, nullptr, this, nullptr);
+    m_streamSource->detach(m_videoWidget->videoSink());
+    m_streamSource = nullptr;
 }
 
 void VideoStreamWidget::setupTimers()
@@ -141,7 +178,7 @@ void VideoStreamWidget::startStream(const QString &rtspUrl)
     }
     
     m_rtspUrl = rtspUrl;
-    m_reconnectAttempts = 0;
+    m_reconnectScheduler->reset();
     
     qDebug() << "스트림 시작 시도:" << rtspUrl;
     
@@ -149,10 +186,8 @@ void VideoStreamWidget::startStream(const QString &rtspUrl)
     m_connectionTimer->start();
     m_statusUpdateTimer->start();
     
-    // RTSP URL 설정 및 재생 시작
-    QUrl url(rtspUrl);
-    m_mediaPlayer->setSource(url);
-    m_mediaPlayer->play();
+    // 공유 소스에 연결 (첫 화면이면 세션을 열고 재생 시작)
+    attachSource();
     
     m_isStreaming = true;
 }
@@ -164,16 +199,16 @@ void VideoStreamWidget::stopStream()
     m_isStreaming = false;
     
     // 타이머 중지
+    m_reconnectScheduler->cancel();
     m_connectionTimer->stop();
     m_liveBlinkTimer->stop();
     m_statusUpdateTimer->stop();
     
-    // 미디어 플레이어 중지
-    if (m_mediaPlayer) {
-        m_mediaPlayer->stop();
-    }
+    // 공유 소스에서 분리 (마지막 화면이었으면 세션 종료)
+    detachSource();
     
     m_liveIndicator->setVisible(false);
+    m_delayLabel->setVisible(false);
     showConnectionStatus("스트림 중지됨", "#666");
     
     qDebug() << "스트림 중지됨";
@@ -216,7 +251,7 @@ void VideoStreamWidget::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
         m_connectionTimer->stop();
         m_liveIndicator->setVisible(true);
         m_liveBlinkTimer->start();
-        m_reconnectAttempts = 0;
+        m_reconnectScheduler->reset();
         CustomMessageBox msgBox(nullptr, "RTSP 연결", "RTSP 연결에 성공했습니다!");
         msgBox.setFixedSize(300,150);
         msgBox.exec();
@@ -229,14 +264,14 @@ void VideoStreamWidget::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
         m_connectionTimer->stop();
         m_liveIndicator->setVisible(true);
         m_liveBlinkTimer->start();
-        m_reconnectAttempts = 0;
+        m_reconnectScheduler->reset();
         qDebug() << "버퍼링 완료 - 스트림 재생 시작";
         break;
         
     case QMediaPlayer::EndOfMedia:
         qDebug() << "스트림 종료됨";
         if (m_isStreaming) {
-            QTimer::singleShot(5000, this, &VideoStreamWidget::attemptReconnection);
+            attemptReconnection();
         }
         break;
         
@@ -304,9 +339,13 @@ void VideoStreamWidget::onErrorOccurred(QMediaPlayer::Error error, const QString
     
     showConnectionStatus("에러 발생", "#f44336");
     emit streamError(errorMsg);
-    CustomMessageBox msgBox(nullptr, "RTSP 연결 실패", errorMsg);
-    msgBox.setFixedSize(300,150);
-    msgBox.exec();
+
+    // 재연결 중 반복되는 실패마다 모달 창을 띄우지 않도록 첫 실패에만 알림
+    if (m_reconnectScheduler->attempts() == 0) {
+        CustomMessageBox msgBox(nullptr, "RTSP 연결 실패", errorMsg);
+        msgBox.setFixedSize(300,150);
+        msgBox.exec();
+    }
 
     if (m_isStreaming) {
         attemptReconnection();
@@ -323,31 +362,35 @@ void VideoStreamWidget::onConnectionTimeout()
 
 void VideoStreamWidget::attemptReconnection()
 {
-    if (m_reconnectAttempts >= MAX_RECONNECT_ATTEMPTS) {
-        qDebug() << "최대 재연결 시도 횟수 초과";
-        stopStream();
-        emit streamError("최대 재연결 시도 횟수를 초과했습니다");
+    // 현재 재생 중지
+    m_connectionTimer->stop();
+    if (m_streamSource) {
+        m_streamSource->player()->stop();
+    }
+
+    // 백오프 지연 후 onReconnectRequested 호출 (이미 예약되어 있으면 무시)
+    m_reconnectScheduler->schedule();
+}
+
+void VideoStreamWidget::onReconnectRequested(int attempt)
+{
+    if (m_rtspUrl.isEmpty() || !m_isStreaming) {
         return;
     }
-    
-    m_reconnectAttempts++;
-    showConnectionStatus(QString("재연결 시도 중... (%1/%2)").arg(m_reconnectAttempts).arg(MAX_RECONNECT_ATTEMPTS), "#ff9800");
-    
-    // 현재 재생 중지
-    if (m_mediaPlayer) {
-        m_mediaPlayer->stop();
+
+    qDebug() << "재연결 시도:" << attempt;
+    showConnectionStatus(QString("재연결 시도 중... (%1)").arg(attempt), "#ff9800");
+    m_connectionTimer->start();
+    if (m_streamSource) {
+        m_streamSource->restart();
     }
-    
-    // 잠시 대기 후 재연결 시도
-    QTimer::singleShot(3000, this, [this]() {
-        if (!m_rtspUrl.isEmpty() && m_isStreaming) {
-            qDebug() << "재연결 시도:" << m_reconnectAttempts;
-            m_connectionTimer->start();
-            QUrl url(m_rtspUrl);
-            m_mediaPlayer->setSource(url);
-            m_mediaPlayer->play();
-        }
-    });
+}
+
+void VideoStreamWidget::onReconnectGaveUp()
+{
+    qDebug() << "최대 재연결 시도 횟수 초과";
+    stopStream();
+    emit streamError("최대 재연결 시도 횟수를 초과했습니다");
 }
 
 void VideoStreamWidget::updateConnectionStatus()
@@ -357,16 +400,39 @@ void VideoStreamWidget::updateConnectionStatus()
     }
     
     // 미디어 플레이어 상태 확인
-    if (m_mediaPlayer->playbackState() == QMediaPlayer::PlayingState &&
-        m_mediaPlayer->mediaStatus() == QMediaPlayer::BufferedMedia) {
+    const QMediaPlayer *player = m_streamSource ? m_streamSource->player() : nullptr;
+    if (player && player->playbackState() == QMediaPlayer::PlayingState &&
+        player->mediaStatus() == QMediaPlayer::BufferedMedia) {
         
-        if (m_reconnectAttempts > 0) {
-            m_reconnectAttempts = 0;
+        if (m_reconnectScheduler->attempts() > 0) {
+            m_reconnectScheduler->reset();
             showConnectionStatus("연결 복구됨", "#4caf50");
         }
     }
 }
 
+void VideoStreamWidget::onPlaybackDelayChanged(qint64 delayMs, int droppedFrames)
+{
+    if (delayMs < 0) {
+        m_delayLabel->setVisible(false);
+        return;
+    }
+
+    QString text = QString("지연 %1ms").arg(delayMs);
+    if (droppedFrames > 0) {
+        text += QString(" · 드롭 %1").arg(droppedFrames);
+    }
+    QString color = "#4caf50";
+    if (delayMs > m_liveOptions.maxDelayMs) {
+        color = "#f44336";
+    } else if (delayMs > m_liveOptions.targetDelayMs) {
+        color = "#ff9800";
+    }
+    m_delayLabel->setText(text);
+    m_delayLabel->setStyleSheet(QString("color: %1; font-size: 12px;").arg(color));
+    m_delayLabel->setVisible(true);
+}
+
 void VideoStreamWidget::showConnectionStatus(const QString &status, const QString &color)
 {
     m_statusLabel->setText(status);
@@ -9,7 +9,10 @@
 #include <QMouseEvent>
 #include <QMediaPlayer>
 #include <QVideoWidget>
-#include <QAudioOutput>
+
+#include "RtspStreamSource.h"
+
+class ReconnectScheduler;
 
 class VideoStreamWidget : public QWidget
 {
@@ -23,6 +26,7 @@ public:
     void stopStream();
     bool isStreaming() const;
     void setStreamUrl(const QString &url);
+    ReconnectScheduler *reconnectScheduler() const { return m_reconnectScheduler; }
 
 signals:
     void clicked();
@@ -38,11 +42,15 @@ private slots:
     void onErrorOccurred(QMediaPlayer::Error error, const QString &errorString);
     void onConnectionTimeout();
     void attemptReconnection();
+    void onReconnectRequested(int attempt);
+    void onReconnectGaveUp();
     void updateConnectionStatus();
+    void onPlaybackDelayChanged(qint64 delayMs, int droppedFrames);
 
 private:
     void setupUI();
-    void setupMediaPlayer();
+    void attachSource();
+    void detachSource();
     void setupTimers();
     void showConnectionStatus(const QString &status, const QString &color);
 
@@ -50,24 +58,26 @@ private:
     QVideoWidget *m_videoWidget;
     QLabel *m_statusLabel;
     QLabel *m_liveIndicator;
+    QLabel *m_delayLabel;           // 측정한 재생 지연 (캡처 → 화면)
     QVBoxLayout *m_layout;
 
-    // 미디어 플레이어
-    QMediaPlayer *m_mediaPlayer;
-    QAudioOutput *m_audioOutput;
+    // 공유 RTSP 소스 (LineDrawingDialog 와 같은 세션/디코더를 씀)
+    RtspStreamSource *m_streamSource;
+    RtspStreamSource::LiveOptions m_liveOptions;    // 저지연 재생 설정 (EnvConfig)
 
     // 타이머
     QTimer *m_connectionTimer;
     QTimer *m_liveBlinkTimer;
     QTimer *m_statusUpdateTimer;
 
+    // 재연결 (TcpCommunicator 와 같은 백오프 스케줄러 사용)
+    ReconnectScheduler *m_reconnectScheduler;
+
     // 상태 변수
     QString m_rtspUrl;
     bool m_isStreaming;
-    int m_reconnectAttempts;
 
     // 상수
-    static const int MAX_RECONNECT_ATTEMPTS = 5;
     static const int CONNECTION_TIMEOUT_MS = 15000; // 15초
 };
 
@@ -6,6 +6,9 @@
 #include "LoginWindow.h"
 #include "MainWindow.h"
 #include "TcpCommunicator.h"
+#include "EnvConfig.h"
+#include "ReconnectScheduler.h"
+#include <QStandardPaths>
 
 int main(int argc, char *argv[])
 {
@@ -53,6 +56,30 @@ int main(int argc, char *argv[])
     // 공유 TcpCommunicator 생성
     TcpCommunicator *sharedTcpCommunicator = new TcpCommunicator();
 
+    // TLS 세션 티켓을 디스크에 보관해 재시작 후에도 세션 재개 (TLS_SESSION_CACHE=false 로 끔)
+    EnvConfig::loadFromFile();
+    if (EnvConfig::getBoolValue("TLS_SESSION_CACHE", true)) {
+        sharedTcpCommunicator->setTlsSessionCacheFile(
+            QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/tls_session_cache.json");
+    }
+
+    // 수신 프레임을 파일로 기록 (tools/payload_bench 입력용, 기본 꺼짐)
+    const QString trafficRecordFile = EnvConfig::getValue("TRAFFIC_RECORD_FILE");
+    if (!trafficRecordFile.isEmpty()) {
+        sharedTcpCommunicator->setTrafficRecordFile(trafficRecordFile);
+    }
+
+    // 받은 캡처를 디스크에 캐시해 같은 시간대를 다시 열 때 서버에서 다시 받지 않음 (CAPTURE_CACHE_MB=0 이면 끔)
+    const int captureCacheMb = EnvConfig::getIntValue("CAPTURE_CACHE_MB", 512);
+    if (captureCacheMb > 0) {
+        sharedTcpCommunicator->setCaptureCache(
+            QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/captures",
+            static_cast<qint64>(captureCacheMb) * 1024 * 1024);
+    }
+
+    // 무인 관제 콘솔은 서버가 돌아올 때까지 계속 재연결
+    sharedTcpCommunicator->reconnectScheduler()->setNeverGiveUp(EnvConfig::getBoolValue("RECONNECT_NEVER_GIVE_UP", false));
+
     // 로그인 창 생성 및 표시
     LoginWindow loginWindow;
 
@@ -66,6 +93,14 @@ int main(int argc, char *argv[])
     QObject::connect(&loginWindow, &LoginWindow::loginSuccessful, [&]() {
         qDebug() << "로그인 성공 - 메인 창 표시";
 
+        // 로그인 후 서버와 CBOR 페이로드 사용 여부 협상 (CBOR_PAYLOAD=false 면 JSON 유지)
+        if (EnvConfig::getBoolValue("CBOR_PAYLOAD", true)) {
+            sharedTcpCommunicator->negotiatePayloadEncoding();
+        }
+
+        // 서버와의 시계 차이/왕복 시간 추정 (BBox 오버레이 동기화, 지연 측정용, CLOCK_SYNC_INTERVAL_MS=0 이면 끔)
+        sharedTcpCommunicator->startClockSync(EnvConfig::getIntValue("CLOCK_SYNC_INTERVAL_MS", 10000));
+
         MainWindow *mainWindow = new MainWindow();
 
         mainWindow->setWindowFlags(Qt::Window | Qt::FramelessWindowHint);
@@ -0,0 +1,225 @@
+// 페이로드 인코딩 벤치마크 (JSON vs 정수 키 CBOR)
+//
+// 앱을 TRAFFIC_RECORD_FILE=<경로> 로 실행해 수신 프레임을 기록한 뒤:
+//   payload_bench <기록 파일> [-n 반복 횟수]
+// request_id 별로 프레임당 전송 바이트와 파싱 시간(페이로드 → QJsonObject)을 비교하고,
+// response_id 200 은 JSON/CBOR → QList<BBox> 경로와 바이너리 BBox 프레임 디코드의 처리량을 비교한다.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QMap>
+#include <QTextStream>
+
+#include "BBoxFrame.h"
+#include "FrameDecoder.h"
+#include "PayloadCodec.h"
+
+namespace {
+struct Sample {
+    int requestId = 0;
+    QByteArray json;
+    QByteArray cbor;
+    QByteArray binary;      // response_id 200 만
+};
+
+struct Totals {
+    int frames = 0;
+    qint64 jsonBytes = 0;
+    qint64 cborBytes = 0;
+    qint64 jsonNs = 0;
+    qint64 cborNs = 0;
+};
+
+qint64 timeDecode(const QByteArray &payload, int iterations)
+{
+    QJsonObject message;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        PayloadCodec::decode(payload, message);
+    }
+    return timer.nsecsElapsed() / iterations;
+}
+
+// 페이로드 → QList<BBox> 전체 경로 (앱의 수신 경로와 동일)
+qint64 timeBBoxDecode(const QByteArray &payload, int iterations)
+{
+    QList<BBox> bboxes;
+    qint64 timestamp = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        if (BBoxFrame::isBBoxFrame(payload)) {
+            BBoxFrame::decode(payload, bboxes, timestamp);
+        } else {
+            QJsonObject message;
+            PayloadCodec::decode(payload, message);
+            BBoxFrame::fromJson(message, bboxes, timestamp);
+        }
+    }
+    return timer.nsecsElapsed() / iterations;
+}
+
+QString row(const QString &label, const Totals &totals)
+{
+    const double frames = qMax(1, totals.frames);
+    const double jsonBytes = totals.jsonBytes / frames;
+    const double cborBytes = totals.cborBytes / frames;
+    const double jsonUs = totals.jsonNs / frames / 1000.0;
+    const double cborUs = totals.cborNs / frames / 1000.0;
+
+    return QString("%1 %2 %3 %4 %5 %6 %7 %8")
+        .arg(label, -10)
+        .arg(totals.frames, 7)
+        .arg(jsonBytes, 11, 'f', 0)
+        .arg(cborBytes, 11, 'f', 0)
+        .arg(jsonBytes > 0 ? cborBytes / jsonBytes * 100.0 : 0.0, 7, 'f', 1)
+        .arg(jsonUs, 10, 'f', 2)
+        .arg(cborUs, 10, 'f', 2)
+        .arg(cborUs > 0 ? jsonUs / cborUs : 0.0, 7, 'f', 2);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compare JSON and CBOR payloads on recorded traffic.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Recorded frames (4-byte big-endian length + payload).");
+    QCommandLineOption iterationsOption({ "n", "iterations" }, "Decode iterations per frame.", "count", "200");
+    parser.addOption(iterationsOption);
+    parser.process(app);
+
+    if (parser.positionalArguments().isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+
+    QFile file(parser.positionalArguments().first());
+    if (!file.open(QIODevice::ReadOnly)) {
+        out << "Cannot open " << file.fileName() << Qt::endl;
+        return 1;
+    }
+
+    // 기록 파일은 소켓과 같은 프레임 형식이므로 앱의 디코더로 그대로 나눈다
+    FrameDecoder decoder;
+    decoder.append(file.readAll());
+
+    QList<Sample> samples;
+    QByteArrayView frame;
+    while (decoder.nextFrame(frame) == FrameDecoder::Status::FrameReady) {
+        QJsonObject message;
+        if (BBoxFrame::isBBoxFrame(frame)) {
+            // 바이너리로 기록된 BBox 프레임은 같은 내용의 JSON 메시지로 되돌려 비교
+            QList<BBox> bboxes;
+            qint64 timestamp = 0;
+            if (!BBoxFrame::decode(frame, bboxes, timestamp)) {
+                continue;
+            }
+            QJsonArray bboxArray;
+            for (const BBox &bbox : bboxes) {
+                bboxArray.append(QJsonObject{
+                    { "id", bbox.object_id }, { "type", bbox.type }, { "confidence", bbox.confidence },
+                    { "x", bbox.rect.x() }, { "y", bbox.rect.y() },
+                    { "width", bbox.rect.width() }, { "height", bbox.rect.height() } });
+            }
+            message["response_id"] = 200;
+            message["timestamp"] = timestamp;
+            message["bboxes"] = bboxArray;
+        } else if (!PayloadCodec::decode(frame, message)) {
+            continue;
+        }
+
+        Sample sample;
+        sample.requestId = message["request_id"].toInt();
+        if (sample.requestId == 0) {
+            sample.requestId = message["response_id"].toInt();
+        }
+        sample.json = PayloadCodec::encode(message, PayloadCodec::Encoding::Json);
+        sample.cbor = PayloadCodec::encode(message, PayloadCodec::Encoding::Cbor);
+        if (sample.requestId == 200) {
+            QList<BBox> bboxes;
+            qint64 timestamp = 0;
+            BBoxFrame::fromJson(message, bboxes, timestamp);
+            sample.binary = BBoxFrame::encode(bboxes, timestamp);
+        }
+        samples.append(sample);
+    }
+
+    if (samples.isEmpty()) {
+        out << "No decodable frames in " << file.fileName() << Qt::endl;
+        return 1;
+    }
+
+    QMap<int, Totals> byRequestId;
+    Totals overall;
+    for (const Sample &sample : samples) {
+        Totals &totals = byRequestId[sample.requestId];
+        const qint64 jsonNs = timeDecode(sample.json, iterations);
+        const qint64 cborNs = timeDecode(sample.cbor, iterations);
+
+        for (Totals *t : { &totals, &overall }) {
+            t->frames++;
+            t->jsonBytes += sample.json.size();
+            t->cborBytes += sample.cbor.size();
+            t->jsonNs += jsonNs;
+            t->cborNs += cborNs;
+        }
+    }
+
+    out << "frames: " << samples.size() << ", iterations per frame: " << iterations << Qt::endl;
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8")
+               .arg("request_id", -10).arg("frames", 7)
+               .arg("json B/frm", 11).arg("cbor B/frm", 11).arg("size %", 7)
+               .arg("json us", 10).arg("cbor us", 10).arg("speedup", 7)
+        << Qt::endl;
+    for (auto it = byRequestId.constBegin(); it != byRequestId.constEnd(); ++it) {
+        out << row(QString::number(it.key()), it.value()) << Qt::endl;
+    }
+    out << row("all", overall) << Qt::endl;
+
+    // response_id 200: 디코드 결과(QList<BBox>)까지의 처리량
+    int bboxFrames = 0;
+    qint64 jsonNs = 0, cborNs = 0, binaryNs = 0;
+    qint64 jsonBytes = 0, cborBytes = 0, binaryBytes = 0;
+    for (const Sample &sample : samples) {
+        if (sample.binary.isEmpty()) {
+            continue;
+        }
+        bboxFrames++;
+        jsonNs += timeBBoxDecode(sample.json, iterations);
+        cborNs += timeBBoxDecode(sample.cbor, iterations);
+        binaryNs += timeBBoxDecode(sample.binary, iterations);
+        jsonBytes += sample.json.size();
+        cborBytes += sample.cbor.size();
+        binaryBytes += sample.binary.size();
+    }
+
+    if (bboxFrames > 0) {
+        auto bboxRow = [&](const QString &label, qint64 bytes, qint64 ns) {
+            const double usPerFrame = ns / double(bboxFrames) / 1000.0;
+            return QString("%1 %2 %3 %4")
+                .arg(label, -10)
+                .arg(bytes / double(bboxFrames), 11, 'f', 0)
+                .arg(usPerFrame, 10, 'f', 2)
+                .arg(usPerFrame > 0 ? 1e6 / usPerFrame : 0.0, 12, 'f', 0);
+        };
+
+        out << Qt::endl << "bbox frames (response_id 200): " << bboxFrames << Qt::endl;
+        out << QString("%1 %2 %3 %4")
+                   .arg("format", -10).arg("B/frm", 11).arg("us/frm", 10).arg("frames/s", 12)
+            << Qt::endl;
+        out << bboxRow("json", jsonBytes, jsonNs) << Qt::endl;
+        out << bboxRow("cbor", cborBytes, cborNs) << Qt::endl;
+        out << bboxRow("binary", binaryBytes, binaryNs) << Qt::endl;
+    }
+
+    return 0;
+}
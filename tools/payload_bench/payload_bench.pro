@@ -0,0 +1,21 @@
+QT += core gui network
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = payload_bench
+TEMPLATE = app
+
+# 앱과 같은 코덱/프레임 디코더를 그대로 사용
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../PayloadCodec.cpp \
+    ../../BBoxFrame.cpp \
+    ../../FrameDecoder.cpp
+
+HEADERS += \
+    ../../PayloadCodec.h \
+    ../../BBoxFrame.h \
+    ../../FrameDecoder.h